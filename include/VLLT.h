@@ -12,10 +12,12 @@
 #include <type_traits>
 #include <vector>
 #include <queue>
+#include <deque>
 #include <thread>
 #include <latch>
 #include <numeric>
 #include <string>
+#include <stdexcept>
 #include <cstdlib>
 #include <random>
 #include <functional>
@@ -24,9 +26,35 @@
 #include <compare>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <typeinfo>
 #include <typeindex>
 #include <any>
+#include <span>
+#include <ranges>
+#include <bit>
+#include <cstring>
+#include <coroutine>
+#include <variant>
+#include <unordered_map>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+	#if defined(__linux__)
+		#include <sys/syscall.h>
+	#endif
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#include <immintrin.h>
+#endif
 
 #include "VTLL.h"
 #include "VSTY.h"
@@ -88,18 +116,32 @@ namespace vllt {
 
 	/// Syncronization type for the table
 	const int VLLT_SYNC_PUSHBACK = 128;		///< relaxed sync, views with pushback are allowed
+	const int VLLT_SYNC_APPEND_ONLY = 256;	///< rows are never removed, slots are claimed with fetch_add
 	enum class sync_t : int {
 		VLLT_SYNC_EXTERNAL = 0,		///< sync is done externally
 		VLLT_SYNC_EXTERNAL_PUSHBACK = VLLT_SYNC_EXTERNAL | VLLT_SYNC_PUSHBACK,	///< sync is done externally, views with pushback only are allowed
 		VLLT_SYNC_INTERNAL = 1,		///< full internal sync
 		VLLT_SYNC_INTERNAL_PUSHBACK = VLLT_SYNC_INTERNAL | VLLT_SYNC_PUSHBACK,	///< internal sync, can add rows in parallel by pushback only views
 		VLLT_SYNC_DEBUG = 2,		///< debugging full internal sync - error if violation
-		VLLT_SYNC_DEBUG_PUSHBACK = VLLT_SYNC_DEBUG | VLLT_SYNC_PUSHBACK	///< debugging relaxed internal sync - error if violation, pushback only views allowed
+		VLLT_SYNC_DEBUG_PUSHBACK = VLLT_SYNC_DEBUG | VLLT_SYNC_PUSHBACK,	///< debugging relaxed internal sync - error if violation, pushback only views allowed
+		VLLT_SYNC_EXTERNAL_APPEND_ONLY = VLLT_SYNC_EXTERNAL_PUSHBACK | VLLT_SYNC_APPEND_ONLY,	///< like VLLT_SYNC_EXTERNAL_PUSHBACK, but rows cannot be removed and appends are wait-free
+		VLLT_SYNC_INTERNAL_APPEND_ONLY = VLLT_SYNC_INTERNAL_PUSHBACK | VLLT_SYNC_APPEND_ONLY,	///< like VLLT_SYNC_INTERNAL_PUSHBACK, but rows cannot be removed and appends are wait-free
+		VLLT_SYNC_DEBUG_APPEND_ONLY = VLLT_SYNC_DEBUG_PUSHBACK | VLLT_SYNC_APPEND_ONLY	///< like VLLT_SYNC_DEBUG_PUSHBACK, but rows cannot be removed and appends are wait-free
+	};
+
+	/// Storage engines for the blocks of a static table
+	enum class storage_t : int {
+		VLLT_STORAGE_BLOCK_MAP = 0,	///< a vector of block pointers, replaced by a larger copy if it is too small
+		VLLT_STORAGE_SEGMENTED = 1,	///< a fixed directory of geometrically growing segments of block pointers, never copied
+		VLLT_STORAGE_VIRTUAL = 2	///< one reserved range of virtual memory per column, pages are committed as the table grows
 	};
 
 	/// Tag for template parameter list to indicate that the view has write access
 	struct VlltWrite {};		///< Types before this tag have read access, types after this tag have write access
 
+	/// Tag for view<VlltWrite, VlltChunk>(), a pushback-only view that buffers rows locally and adds them in chunks
+	struct VlltChunk {};
+
 	class VlltTableBase;
 
 	template<sync_t SYNC, size_t N0, size_t MINSLOTS, bool FAIR>
@@ -113,9 +155,68 @@ namespace vllt {
 	//Static Table
 
 
+	/// \brief Uninitialized storage for N objects of type T. Objects are constructed and destroyed explicitly
+	/// when rows are added or removed, so allocating a block does not construct anything.
+	/// \tparam T Type of the objects.
+	/// \tparam N Number of objects.
+	/// \tparam A Alignment of the first object. The size of the storage is padded to a multiple of A.
+	template<typename T, size_t N, size_t A = alignof(T)>
+	struct VlltStorage {
+		static_assert( std::has_single_bit(A) && A >= alignof(T), "The alignment of a storage must be a power of 2, and at least the alignment of its type!" );
+		VlltStorage() noexcept {}; ///< User provided, so value initialization does not zero the storage
+		inline auto data() noexcept -> T* { return std::launder(reinterpret_cast<T*>(m_data)); } ///< \returns pointer to the first object
+		inline auto operator[](size_t n) noexcept -> T& { return data()[n]; } ///< \returns reference to object n
+		alignas(A) std::byte m_data[ (N * sizeof(T) + A - 1) / A * A ]; ///< Raw memory for the objects, padded to the alignment
+	};
+
+	/// Concept demanding that each column of a table can be constructed from the respective argument
+	template<typename DATA, typename... Args>
+	concept VlltConstructible = (vtll::size<DATA>::value == sizeof...(Args)) && ([]<size_t... Is>(std::index_sequence<Is...>) {
+		return (std::is_constructible_v<vtll::Nth_type<DATA, Is>, vtll::Nth_type<vtll::tl<Args...>, Is>> && ...);
+	}(std::make_index_sequence<sizeof...(Args)>{}));
+
+	/// A column group of a table layout is a type list of columns, which are stored interleaved. Any other type is a column of its own.
+	template<typename G> struct VlltGroupImpl { using type = vtll::tl<G>; };
+	template<typename... Ts> struct VlltGroupImpl<vtll::tl<Ts...>> { using type = vtll::tl<Ts...>; };
+	template<typename G> using VlltGroup = typename VlltGroupImpl<G>::type; ///< The columns of a group
+
+	/// The columns of a table layout, i.e., the layout with all column groups flattened. 
+	template<typename LAYOUT> struct VlltColumnsImpl;
+	template<typename... Gs> struct VlltColumnsImpl<vtll::tl<Gs...>> { using type = vtll::flatten<vtll::tl<VlltGroup<Gs>...>>; };
+	template<typename LAYOUT> using VlltColumns = typename VlltColumnsImpl<LAYOUT>::type;
+
+	/// \brief Raw memory for one row of a column group. The columns are stored one after the other in the given order, 
+	/// each aligned as needed, so columns that are accessed together share cache lines.
+	template<typename G> struct VlltGroupRow;
+	template<typename... Ts> 
+	struct VlltGroupRow<vtll::tl<Ts...>> {
+		static constexpr std::array<size_t, sizeof...(Ts) + 1> OFFSETS = []() { ///< Offsets of the columns, and the end of the last column
+			std::array<size_t, sizeof...(Ts) + 1> offsets{};
+			size_t offset = 0, i = 0;
+			( (offset = (offset + alignof(Ts) - 1) / alignof(Ts) * alignof(Ts), offsets[i++] = offset, offset += sizeof(Ts)), ... );
+			offsets[i] = offset;
+			return offsets;
+		}();
+		static constexpr size_t ALIGN = std::max({ alignof(Ts)... }); ///< Alignment of the row
+
+		template<size_t I> ///< \returns pointer to column I of the row
+		inline auto get() noexcept -> vtll::Nth_type<vtll::tl<Ts...>, I>* { 
+			return std::launder(reinterpret_cast<vtll::Nth_type<vtll::tl<Ts...>, I>*>(m_data + OFFSETS[I])); 
+		}
+		alignas(ALIGN) std::byte m_data[ (OFFSETS.back() + ALIGN - 1) / ALIGN * ALIGN ]; ///< Raw memory for the columns
+	};
+
+	/// What a table stores per row for a column group: the column itself for a single column, otherwise a VlltGroupRow
+	template<typename G> 
+	using VlltGroupRowType = std::conditional_t< vtll::size<VlltGroup<G>>::value == 1, vtll::Nth_type<VlltGroup<G>, 0>, VlltGroupRow<VlltGroup<G>> >;
+
+	template<typename LAYOUT> struct VlltGroupRowsImpl;
+	template<typename... Gs> struct VlltGroupRowsImpl<vtll::tl<Gs...>> { using type = vtll::tl<VlltGroupRowType<Gs>...>; };
+	template<typename LAYOUT> using VlltGroupRows = typename VlltGroupRowsImpl<LAYOUT>::type; ///< Row types of all column groups
+
 	/// Concept demanding that types of a table must be unique
-	template<typename DATA>
-	concept VlltStaticTableConcept = vtll::unique<DATA>::value;
+	template<typename LAYOUT>
+	concept VlltStaticTableConcept = vtll::unique<VlltColumns<LAYOUT>>::value;
 
 	/// Concept for view. Types must be unique, and no type must be in both READ and WRITE
 	/// Currently defunct because of compiler error
@@ -128,23 +229,35 @@ namespace vllt {
 	);
 
 	/// Forward declaration of VlltStaticTable
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR>
-		requires VlltStaticTableConcept<DATA>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN>
+		requires VlltStaticTableConcept<LAYOUT>
 	class VlltStaticTable;
 
 	/// Forward declaration of VlltStaticTableViewBase
 	class VlltStaticTableViewBase;
 
 	/// Used for accessing a table.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, typename READ, typename WRITE>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ, typename WRITE>
 	class VlltStaticTableView;
 
+	/// Used for reading a table without locks.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ>
+	class VlltOptimisticView;
+
+	/// Awaiter for creating a view in a coroutine.
+	template<typename VIEW>
+	class VlltViewAwaiter;
+
+	/// Specification of a view for acquire().
+	template<typename VIEW>
+	struct VlltViewSpec;
+
 	class VtllStaticIteratorBase;
 
 	class VtllStaticIteratorBaseWrapper;
 
 	/// Iterator forward declaration
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, typename READ, typename WRITELIST, typename WRITE>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ, typename WRITELIST, typename WRITE>
 	class VtllStaticIterator;
 
 
@@ -155,6 +268,10 @@ namespace vllt {
 	template<sync_t SYNC>
 	concept VlltAllowOnlyPushback = (((int)SYNC & VLLT_SYNC_PUSHBACK) != 0);
 
+	// A TABLE that satisfies this concept NEVER REMOVES rows, so pop_back(), erase() and clear() are not available.
+	template<sync_t SYNC>
+	concept VlltAppendOnly = (((int)SYNC & VLLT_SYNC_APPEND_ONLY) != 0);
+
 	//a VIEW that satisfies this concept has write access to all columns of the table is the owner and can add, pop, erase, and change anything
 	template<typename DATA, typename WRITE>
 	concept VlltWriteAll = vtll::is_same_set<DATA, WRITE>::value; ///< Is the view the owner of the table?
@@ -162,12 +279,27 @@ namespace vllt {
 	// A VIEW that satisfies this concept is a push-back only view, i.e., it can only add rows to the table but nothing else,
 	// even though it is also an owner.
 	template<typename WRITELIST>
-	concept VlltOnlyPushback = vtll::is_same_set<WRITELIST, vtll::tl<VlltWrite>>::value; ///< Is the view only allowed to push back?
+	concept VlltOnlyPushback = vtll::has_type<WRITELIST, VlltWrite>::value; ///< Is the view only allowed to push back?
+
+	// A VIEW that satisfies this concept is a push-back only view that buffers pushed rows locally, and adds them 
+	// to the table with flush(), which reserves and commits their slots with one atomic operation each.
+	template<typename WRITELIST>
+	concept VlltChunkedPushback = vtll::is_same_set<WRITELIST, vtll::tl<VlltWrite, VlltChunk>>::value; ///< Does the view push back in chunks?
 
 	// A VIEW that satisfies this concept is the owner of the table and can add, pop, erase, and change anything
 	template<typename DATA, typename WRITE, typename WRITELIST>
 	concept VlltOwner = (VlltWriteAll<DATA, WRITE> && !VlltOnlyPushback<WRITELIST>);
 
+	// A VIEW that satisfies this concept is the owner of the table and can remove rows
+	template<typename DATA, sync_t SYNC, typename WRITE, typename WRITELIST>
+	concept VlltRemover = (VlltOwner<DATA, WRITE, WRITELIST> && !VlltAppendOnly<SYNC>);
+
+	// Columns that satisfy this concept can be read by optimistic views, i.e., they can be copied while they are written to.
+	template<typename READ>
+	concept VlltOptimisticReadable = []<size_t... Is>(std::index_sequence<Is...>) {
+		return (std::is_trivially_copyable_v<vtll::Nth_type<READ, Is>> && ...);
+	}(std::make_index_sequence<vtll::size<READ>::value>{});
+
 
 
 
@@ -255,71 +387,1081 @@ namespace vllt {
 
 
 	//---------------------------------------------------------------------------------------------------
+	//Epoch based memory reclamation
+
+	#ifndef VLLT_MAX_NUMBER_OF_EPOCH_SLOTS
+		#define VLLT_MAX_NUMBER_OF_EPOCH_SLOTS 64
+	#endif
+
+	/// \brief Epoch based memory reclamation. A thread pins the current epoch as long as it holds raw pointers
+	/// into a table, e.g. for the lifetime of a view. Memory that has been unlinked from the table is retired,
+	/// and freed only after all threads that might still hold a pointer to it have unpinned their epochs.
+	/// Readers thus only need plain loads, and pay for pinning once per view, not once per access.
+	/// A thread that retires memory it does not access anymore can hand in its own slot, then its own pin does not keep 
+	/// the memory alive. So a thread that holds a view for a long time can still reuse the memory it retired.
+	class VlltEpoch {
+	public:
+		using free_t = void(*)(void* owner, void* ptr); ///< Function that frees a retired pointer
+		static constexpr size_t NO_SLOT = std::numeric_limits<size_t>::max(); ///< The retiring thread has no pinned slot
+		static constexpr size_t OVERFLOW_SLOT = VLLT_MAX_NUMBER_OF_EPOCH_SLOTS; ///< Shared by all pins that found no free slot
+
+		VlltEpoch() = default;
+		~VlltEpoch() { assert(m_retired.empty()); }	///< The owner must call reclaim_all() while it can still free memory
+
+		VlltEpoch(const VlltEpoch&) = delete;
+		VlltEpoch& operator=(const VlltEpoch&) = delete;
+
+		/// \brief Pin the current epoch. Memory retired from now on is not freed until unpin() is called.
+		/// If all slots are in use, the pin shares the overflow slot, which takes the mutex and keeps the epoch of its 
+		/// first pin until all its pins are gone. This never waits for a slot, but frees memory later.
+		/// \returns the index of the slot holding the pinned epoch, or OVERFLOW_SLOT.
+		inline auto pin() noexcept -> size_t {
+			auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+			for( size_t i = 0; i < VLLT_MAX_NUMBER_OF_EPOCH_SLOTS; ++i ) {
+				size_t slot = (start + i) % VLLT_MAX_NUMBER_OF_EPOCH_SLOTS;
+				uint64_t expected = 0;
+				if( m_slots[slot].m_epoch.load(std::memory_order_relaxed) == 0
+					&& m_slots[slot].m_epoch.compare_exchange_strong(expected, m_epoch.load()) ) return slot;
+			}
+			std::scoped_lock lock(m_mutex); //all slots are in use, increase VLLT_MAX_NUMBER_OF_EPOCH_SLOTS if this happens often
+			if( m_num_overflow++ == 0 ) m_overflow_epoch = m_epoch.load(); //retire() holds the mutex, so it sees this pin
+			return OVERFLOW_SLOT;
+		}
+
+		/// \brief Unpin an epoch that has been pinned before. Try to free retired memory.
+		/// \param[in] slot Index of the slot returned by pin().
+		inline auto unpin(size_t slot) noexcept -> void {
+			if( slot == OVERFLOW_SLOT ) {
+				std::scoped_lock lock(m_mutex);
+				if( --m_num_overflow == 0 ) m_overflow_epoch = 0;
+				reclaim_p();
+				return;
+			}
+			m_slots[slot].m_epoch.store(0);
+			if( m_num_retired.load(std::memory_order_relaxed) > 0 ) reclaim();
+		}
+
+		/// \brief Retire a pointer that has already been unlinked. It is freed once no thread can see it anymore.
+		/// \param[in] owner Owner of the memory, is handed to the free function.
+		/// \param[in] ptr Pointer to the retired memory.
+		/// \param[in] fun Function that frees the memory.
+		/// \param[in] slot Slot pinned by the retiring thread, which does not access ptr anymore. This pin is ignored for ptr.
+		inline auto retire(void* owner, void* ptr, free_t fun, size_t slot = NO_SLOT) noexcept -> void {
+			std::scoped_lock lock(m_mutex);
+			auto epoch = m_epoch.fetch_add(1); //threads pinned after this point cannot see ptr. Under the lock, so m_retired is sorted by epoch
+			m_retired.emplace_back(epoch, owner, ptr, fun, slot == OVERFLOW_SLOT ? NO_SLOT : slot); //the overflow slot is shared, so it always counts
+			m_num_retired.store(m_retired.size(), std::memory_order_relaxed);
+			reclaim_p();
+		}
+
+		/// \brief Try to free all retired memory that cannot be seen anymore. Does nothing if another thread is already reclaiming.
+		inline auto reclaim() noexcept -> void {
+			std::unique_lock lock(m_mutex, std::try_to_lock);
+			if( lock ) reclaim_p();
+		}
+
+		/// \brief Free all retired memory. Only call this if no thread has pinned an epoch.
+		inline auto reclaim_all() noexcept -> void {
+			std::scoped_lock lock(m_mutex);
+			for( auto& r : m_retired ) r.m_free(r.m_owner, r.m_ptr);
+			m_retired.clear();
+			m_num_retired.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		struct retired_t {
+			uint64_t	m_epoch;	///< Epoch when the memory was retired
+			void*		m_owner;	///< Owner of the memory
+			void*		m_ptr;		///< Pointer to the memory
+			free_t		m_free;		///< Function freeing the memory
+			size_t		m_slot;		///< Slot of the retiring thread, or NO_SLOT
+		};
+
+		struct alignas(64) slot_t {
+			std::atomic<uint64_t> m_epoch{0};	///< Pinned epoch, 0 if the slot is unused
+		};
+
+		/// \brief Free all retired memory that was retired before the oldest epoch still pinned. Must hold m_mutex.
+		/// The pin of the retiring thread is not counted, so for its own memory the second oldest pin is used.
+		/// A slot that was unpinned and pinned again after the retirement cannot see the memory either.
+		/// Since m_retired is sorted by epoch, only the freed prefix and the first entry that is still visible are looked at.
+		inline auto reclaim_p() noexcept -> void {
+			if( m_retired.empty() ) return;
+			uint64_t oldest = std::numeric_limits<uint64_t>::max(), second = oldest; ///< Oldest and second oldest pinned epochs
+			size_t oldest_slot = NO_SLOT; ///< Slot pinning the oldest epoch
+			for( size_t i = 0; i < m_slots.size(); ++i ) {
+				auto epoch = m_slots[i].m_epoch.load();
+				if( epoch == 0 ) continue;
+				if( epoch < oldest ) { second = oldest; oldest = epoch; oldest_slot = i; }
+				else second = std::min(second, epoch);
+			}
+			if( m_overflow_epoch != 0 && m_overflow_epoch < oldest ) { second = oldest; oldest = m_overflow_epoch; oldest_slot = OVERFLOW_SLOT; }
+			else if( m_overflow_epoch != 0 ) second = std::min(second, m_overflow_epoch);
+			auto visible = [&](const retired_t& r) { return r.m_epoch >= (r.m_slot == oldest_slot ? second : oldest); };
+			while( !m_retired.empty() && !visible(m_retired.front()) ) {
+				auto& r = m_retired.front();
+				r.m_free(r.m_owner, r.m_ptr);
+				m_retired.pop_front();
+			}
+			m_num_retired.store(m_retired.size(), std::memory_order_relaxed);
+		}
+
+		alignas(64) std::atomic<uint64_t> m_epoch{1}; ///< Global epoch, starts at 1 since 0 marks an unused slot
+		std::array<slot_t, VLLT_MAX_NUMBER_OF_EPOCH_SLOTS> m_slots; ///< Epochs pinned by threads
+		std::mutex m_mutex;		///< Protects the list of retired pointers
+		std::deque<retired_t> m_retired;	///< Pointers waiting to be freed, sorted by epoch
+		std::atomic<size_t> m_num_retired{0}; ///< Number of retired pointers, for a quick check without locking
+		size_t m_num_overflow{0};	///< Number of pins sharing the overflow slot, protected by m_mutex
+		uint64_t m_overflow_epoch{0}; ///< Epoch pinned by the overflow slot, 0 if unused, protected by m_mutex
+	};
+
+
+	/// \brief Pins an epoch for the lifetime of the guard.
+	class VlltEpochGuard {
+	public:
+		VlltEpochGuard(VlltEpoch& epoch) noexcept : m_epoch{ epoch }, m_slot{ epoch.pin() } {};
+		~VlltEpochGuard() noexcept { m_epoch.unpin(m_slot); };
+
+		inline auto slot() const noexcept -> size_t { return m_slot; } ///< \returns the slot holding the pinned epoch
+
+		VlltEpochGuard(const VlltEpochGuard&) = delete;
+		VlltEpochGuard& operator=(const VlltEpochGuard&) = delete;
+
+	private:
+		VlltEpoch& m_epoch;	///< Epoch manager of the table
+		size_t m_slot;		///< Slot holding the pinned epoch
+	};
+
+
+
+	//---------------------------------------------------------------------------------------------------
+	//Thread pool
+
+	/// \brief A simple work stealing thread pool. Each worker thread owns a queue of jobs. Workers take jobs from the back of
+	/// their own queue, and steal jobs from the front of other queues if their own queue is empty.
+	class VlltThreadPool {
+	public:
+		using job_t = std::function<void()>; ///< A job that can be run by the pool
+
+		/// \brief Constructor of class VlltThreadPool
+		/// \param[in] num_threads Number of worker threads.
+		VlltThreadPool(size_t num_threads = std::thread::hardware_concurrency()) : m_queues(std::max(num_threads, (size_t)1)) {
+			for( size_t i = 0; i < m_queues.size(); ++i ) m_threads.emplace_back( [this, i](){ work(i); } );
+		}
+
+		/// \brief Destructor of class VlltThreadPool. Stops and joins all worker threads.
+		~VlltThreadPool() {
+			{
+				std::scoped_lock lock(m_mutex);
+				m_stop = true;
+			}
+			m_cv.notify_all();
+			m_threads.clear(); //join
+		}
+
+		VlltThreadPool(const VlltThreadPool&) = delete;
+		VlltThreadPool& operator=(const VlltThreadPool&) = delete;
+
+		inline auto size() noexcept -> size_t { return m_threads.size(); } ///< Return the number of worker threads.
+
+		/// \brief Call fun(i) for all i in [0, num) in parallel and wait until all calls have finished. 
+		/// The calling thread helps running jobs while waiting, so this can also be called from inside a job.
+		/// \param[in] num Number of calls.
+		/// \param[in] fun Function to call, must not throw.
+		template<typename F>
+		inline auto parallel_for(size_t num, F&& fun) -> void {
+			if( num == 0 ) return;
+			auto remaining = std::make_shared<std::atomic<size_t>>(num); //jobs might notify after this function returned
+			for( size_t i = 0; i < num; ++i ) {
+				submit( [&fun, remaining, i]() { 
+					fun(i); 
+					if( remaining->fetch_sub(1) == 1 ) remaining->notify_all();
+				}, i );
+			}
+			wait(*remaining);
+		}
+
+		/// \brief Put a job into a queue and wake up sleeping workers.
+		/// \param[in] job The job, must not throw.
+		/// \param[in] idx The job is put into queue idx modulo the number of queues.
+		inline auto submit(job_t&& job, size_t idx) -> void {
+			{
+				auto& queue = m_queues[idx % m_queues.size()];
+				std::scoped_lock lock(queue.m_mutex);
+				queue.m_jobs.push_back(std::move(job));
+			}
+			m_pending.fetch_add(1);
+			std::scoped_lock lock(m_mutex); //prevent lost wakeups of workers about to sleep
+			m_cv.notify_one();
+		}
+
+		/// \brief Run jobs until a counter is 0. Jobs must call notify_all() on the counter after decreasing it to 0.
+		/// \param[in] remaining The counter.
+		inline auto wait(std::atomic<size_t>& remaining) -> void {
+			for( auto n = remaining.load(); n > 0; n = remaining.load() ) {
+				if( auto job = steal(0) ) { (*job)(); continue; }
+				remaining.wait(n); //all jobs are running on other threads
+			}
+		}
+
+	private:
+		struct alignas(64) queue_t {
+			std::mutex m_mutex;			///< Protects the queue
+			std::deque<job_t> m_jobs;	///< Jobs of a worker thread
+		};
+
+		/// \brief Take a job from the back of the own queue, or steal one from the front of another queue.
+		/// \param[in] idx Index of the own queue.
+		inline auto steal(size_t idx) -> std::optional<job_t> {
+			if( m_pending.load() == 0 ) return std::nullopt;
+			for( size_t i = 0; i < m_queues.size(); ++i ) {
+				auto& queue = m_queues[(idx + i) % m_queues.size()];
+				std::scoped_lock lock(queue.m_mutex);
+				if( queue.m_jobs.empty() ) continue;
+				std::optional<job_t> job;
+				if( i == 0 ) { job = std::move(queue.m_jobs.back()); queue.m_jobs.pop_back(); }
+				else { job = std::move(queue.m_jobs.front()); queue.m_jobs.pop_front(); }
+				m_pending.fetch_sub(1);
+				return job;
+			}
+			return std::nullopt;
+		}
+
+		/// \brief Main loop of a worker thread.
+		inline auto work(size_t idx) -> void {
+			while(true) {
+				if( auto job = steal(idx) ) { (*job)(); continue; }
+				std::unique_lock lock(m_mutex);
+				m_cv.wait(lock, [&]() { return m_stop || m_pending.load() > 0; });
+				if( m_stop ) return;
+			}
+		}
+
+		std::vector<queue_t> m_queues;			///< One queue per worker thread
+		std::vector<std::jthread> m_threads;	///< Worker threads
+		alignas(64) std::atomic<size_t> m_pending{0};	///< Number of jobs in all queues
+		std::mutex m_mutex;						///< For sleeping and waking up workers
+		std::condition_variable m_cv;			///< For sleeping and waking up workers
+		bool m_stop{false};						///< If true, workers terminate
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+
+	#ifndef VLLT_VIRTUAL_MAX_ROWS
+		#define VLLT_VIRTUAL_MAX_ROWS (1ull << 28) ///< Max number of rows of a table using VLLT_STORAGE_VIRTUAL
+	#endif
+
+	/// \brief Reserves and commits virtual memory, used by tables with VLLT_STORAGE_VIRTUAL. Reserved memory 
+	/// takes address space only, pages are backed by physical memory only after they have been committed and touched.
+	struct VlltVirtualMemory {
+
+		/// \returns the size of a page.
+		static inline auto page_size() noexcept -> size_t {
+			#if defined(_WIN32)
+				SYSTEM_INFO info;
+				GetSystemInfo(&info);
+				return info.dwPageSize;
+			#else
+				return (size_t)sysconf(_SC_PAGESIZE);
+			#endif
+		}
+
+		/// \brief Reserve a range of address space that cannot be accessed yet.
+		/// \param[in] bytes Size of the range.
+		/// \returns Pointer to the start of the range, or nullptr if it could not be reserved.
+		static inline auto reserve(size_t bytes) noexcept -> std::byte* {
+			#if defined(_WIN32)
+				return static_cast<std::byte*>( VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS) );
+			#else
+				void* ptr = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				return ptr == MAP_FAILED ? nullptr : static_cast<std::byte*>(ptr);
+			#endif
+		}
+
+		/// \brief Make the bytes [from, to) of a reserved range readable and writable. Committing a range twice is allowed.
+		/// \param[in] base Start of the reserved range.
+		/// \param[in] from First byte to commit, is rounded down to a page boundary.
+		/// \param[in] to End of the bytes to commit, is rounded up to a page boundary.
+		/// \returns true if the pages could be committed.
+		static inline auto commit(std::byte* base, size_t from, size_t to) noexcept -> bool {
+			static const size_t PAGE_SIZE = page_size();
+			from = from & ~(PAGE_SIZE - 1);
+			to = (to + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+			if( from >= to ) return true;
+			#if defined(_WIN32)
+				return VirtualAlloc(base + from, to - from, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+			#else
+				return mprotect(base + from, to - from, PROT_READ | PROT_WRITE) == 0;
+			#endif
+		}
+
+		/// \brief Ask the OS to map physical memory to committed pages now, without changing their contents. 
+		/// Does nothing if the OS does not support this.
+		/// \param[in] ptr Start of the committed bytes.
+		/// \param[in] bytes Number of bytes.
+		static inline auto populate([[maybe_unused]] std::byte* ptr, [[maybe_unused]] size_t bytes) noexcept -> void {
+			#if defined(MADV_POPULATE_WRITE)
+				static const size_t PAGE_SIZE = page_size();
+				auto first = reinterpret_cast<uintptr_t>(ptr) & ~(PAGE_SIZE - 1);
+				madvise(reinterpret_cast<void*>(first), reinterpret_cast<uintptr_t>(ptr) + bytes - first, MADV_POPULATE_WRITE);
+			#endif
+		}
+
+		/// \brief Give a reserved range back to the OS.
+		/// \param[in] base Start of the reserved range.
+		/// \param[in] bytes Size of the range.
+		static inline auto release(std::byte* base, [[maybe_unused]] size_t bytes) noexcept -> void {
+			if( !base ) return;
+			#if defined(_WIN32)
+				VirtualFree(base, 0, MEM_RELEASE);
+			#else
+				munmap(base, bytes);
+			#endif
+		}
+
+		/// \brief Ask the OS to back a range with transparent huge pages. Must be called before the pages are touched.
+		/// \param[in] ptr Start of the range, should be aligned to a huge page.
+		/// \param[in] bytes Size of the range.
+		/// \returns true if the OS accepted the advice.
+		static inline auto advise_huge_pages([[maybe_unused]] std::byte* ptr, [[maybe_unused]] size_t bytes) noexcept -> bool {
+			#if defined(MADV_HUGEPAGE)
+				return madvise(ptr, bytes, MADV_HUGEPAGE) == 0;
+			#else
+				return false;
+			#endif
+		}
+
+		/// \brief Bind the pages of a range to a NUMA node. Must be called before the pages are touched. 
+		/// Uses the mbind system call directly, so libnuma is not needed.
+		/// \param[in] ptr Start of the range, must be page aligned.
+		/// \param[in] bytes Size of the range.
+		/// \param[in] node Index of the NUMA node.
+		/// \returns true if the range was bound, false if the OS does not support NUMA or refused, e.g. in containers.
+		static inline auto bind_node([[maybe_unused]] std::byte* ptr, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t node) noexcept -> bool {
+			#if defined(__linux__) && defined(SYS_mbind)
+				const unsigned long MPOL_BIND_ = 2;
+				std::array<unsigned long, 16> mask{};
+				const size_t BITS = sizeof(unsigned long) * 8;
+				if( node >= mask.size() * BITS ) return false;
+				mask[node / BITS] = 1ul << (node % BITS);
+				return syscall(SYS_mbind, ptr, bytes, MPOL_BIND_, mask.data(), mask.size() * BITS + 1, 0) == 0;
+			#else
+				return false;
+			#endif
+		}
+	};
+
+
+	#ifndef VLLT_PAGE_CHUNK_SIZE
+		#define VLLT_PAGE_CHUNK_SIZE (1ull << 25) ///< Size of the chunks a VlltPageResource maps from the OS
+	#endif
+
+	#ifndef VLLT_HUGE_PAGE_SIZE
+		#define VLLT_HUGE_PAGE_SIZE (1ull << 21) ///< Size of a transparent huge page, chunks are aligned to it
+	#endif
+
+	/// \brief How a VlltPageResource maps its memory.
+	struct VlltPagePolicy {
+		bool m_huge_pages{false};	///< Back the chunks with transparent huge pages
+		int m_numa_node{-1};		///< If not negative, bind the chunks to this NUMA node
+		bool m_first_touch{false};	///< Touch all pages of a new allocation in the allocating thread
+	};
+
+	/// \brief A memory resource for blocks of big tables. Memory is mapped from the OS in chunks of VLLT_PAGE_CHUNK_SIZE bytes, 
+	/// aligned to VLLT_HUGE_PAGE_SIZE, and allocations are cut from the current chunk. Freed allocations are kept in a free 
+	/// list per size and reused for allocations of the same size, since tables allocate blocks of one size only. 
+	/// Memory is given back to the OS when the resource is destroyed, so it must outlive all tables using it.
+	/// Chunks can be backed by transparent huge pages, which reduces TLB misses, and bound to a NUMA node. If the OS does 
+	/// not support this, the memory is mapped normally, see huge_pages() and numa_bound(). With first touch, a new 
+	/// allocation is written to by the thread allocating it, which is the thread that adds the first row to a block, so 
+	/// the OS puts the pages on the NUMA node of this thread. With huge pages, a whole huge page goes to the node of 
+	/// the first thread touching it.
+	class VlltPageResource : public std::pmr::memory_resource {
+	public:
+		/// \brief Constructor of class VlltPageResource.
+		/// \param[in] policy How to map the memory.
+		/// \param[in] chunk_size Size of the chunks mapped from the OS, rounded up to a multiple of VLLT_HUGE_PAGE_SIZE.
+		VlltPageResource( VlltPagePolicy policy = {}, size_t chunk_size = VLLT_PAGE_CHUNK_SIZE ) noexcept 
+			: m_policy{policy}, m_chunk_size{ round_up(std::max(chunk_size, (size_t)1), VLLT_HUGE_PAGE_SIZE) }
+			, m_huge_pages{policy.m_huge_pages}, m_numa_bound{policy.m_numa_node >= 0} {}
+
+		~VlltPageResource() { for( auto& [ptr, bytes] : m_chunks ) VlltVirtualMemory::release(ptr, bytes); }
+
+		VlltPageResource(const VlltPageResource&) = delete;
+		VlltPageResource& operator=(const VlltPageResource&) = delete;
+
+		inline auto policy() const noexcept -> VlltPagePolicy { return m_policy; } ///< \returns the policy of the resource
+		inline auto huge_pages() noexcept -> bool { std::lock_guard<std::mutex> lock(m_mutex); return m_huge_pages; } ///< \returns true if huge pages were asked for and the OS accepted them for all chunks
+		inline auto numa_bound() noexcept -> bool { std::lock_guard<std::mutex> lock(m_mutex); return m_numa_bound; } ///< \returns true if a node was given and all chunks are bound to it
+
+	protected:
+		/// \brief Allocate memory from the free list or the current chunk. Allocations bigger than a chunk get their own chunk.
+		auto do_allocate(size_t bytes, size_t alignment) -> void* override {
+			assert(alignment <= VLLT_HUGE_PAGE_SIZE);
+			bytes = round_up( std::max(bytes, (size_t)1), std::max(alignment, (size_t)64) ); //no false sharing between allocations
+			std::byte* ptr = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if( auto it = m_free.find(bytes); it != m_free.end() && !it->second.empty() ) { //reuse, pages are already touched
+					ptr = it->second.back();
+					it->second.pop_back();
+					return ptr;
+				}
+				m_next = round_up(m_next, alignment);
+				if( m_next > m_end || (size_t)(m_end - m_next) < bytes ) {
+					if( bytes > m_chunk_size / 2 ) { ptr = map_chunk(bytes); } //do not waste the rest of the current chunk
+					else { m_next = map_chunk(m_chunk_size); m_end = m_next + m_chunk_size; }
+				}
+				if( !ptr ) { ptr = m_next; m_next += bytes; }
+			}
+			if( m_policy.m_first_touch ) {
+				static const size_t PAGE_SIZE = VlltVirtualMemory::page_size();
+				auto bytes_ptr = reinterpret_cast<volatile std::byte*>(ptr);
+				for( size_t i = 0; i < bytes; i += PAGE_SIZE ) bytes_ptr[i] = std::byte{0};
+			}
+			return ptr;
+		}
+
+		/// \brief Put memory into the free list of its size.
+		auto do_deallocate(void* ptr, size_t bytes, size_t alignment) -> void override {
+			bytes = round_up( std::max(bytes, (size_t)1), std::max(alignment, (size_t)64) );
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_free[bytes].push_back( static_cast<std::byte*>(ptr) );
+		}
+
+		auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override { return this == &other; }
+
+	private:
+		static inline auto round_up(size_t n, size_t a) noexcept -> size_t { return (n + a - 1) / a * a; }
+		static inline auto round_up(std::byte* p, size_t a) noexcept -> std::byte* { return reinterpret_cast<std::byte*>( round_up(reinterpret_cast<uintptr_t>(p), a) ); }
+
+		/// \brief Map a chunk aligned to a huge page, and apply the policy before any page is touched. Must hold m_mutex.
+		auto map_chunk(size_t bytes) -> std::byte* {
+			bytes = round_up(bytes, VLLT_HUGE_PAGE_SIZE);
+			size_t mapped = bytes + VLLT_HUGE_PAGE_SIZE; //room for alignment
+			auto base = VlltVirtualMemory::reserve(mapped);
+			if( !base || !VlltVirtualMemory::commit(base, 0, mapped) ) {
+				VlltVirtualMemory::release(base, mapped);
+				throw std::bad_alloc{};
+			}
+			m_chunks.emplace_back(base, mapped);
+			auto ptr = round_up(base, VLLT_HUGE_PAGE_SIZE);
+			if( m_policy.m_huge_pages ) m_huge_pages = VlltVirtualMemory::advise_huge_pages(ptr, bytes) && m_huge_pages;
+			if( m_policy.m_numa_node >= 0 ) m_numa_bound = VlltVirtualMemory::bind_node(ptr, bytes, (size_t)m_policy.m_numa_node) && m_numa_bound;
+			return ptr;
+		}
+
+		VlltPagePolicy	m_policy;		///< How to map the memory
+		size_t			m_chunk_size;	///< Size of a chunk
+		std::mutex		m_mutex;		///< Protects the members below, tables allocate blocks rarely
+		std::byte*		m_next{nullptr};	///< Next free byte in the current chunk
+		std::byte*		m_end{nullptr};		///< End of the current chunk
+		std::vector<std::pair<std::byte*, size_t>> m_chunks;	///< All mapped chunks, released by the destructor
+		std::unordered_map<size_t, std::vector<std::byte*>> m_free;	///< Freed allocations by size
+		bool m_huge_pages;	///< False if huge pages were not asked for, or the OS refused them for a chunk
+		bool m_numa_bound;	///< False if no node was given, or the OS refused to bind a chunk to it
+	};
+
+	/// \brief Page resource backed by transparent huge pages.
+	class VlltHugePageResource : public VlltPageResource {
+	public:
+		VlltHugePageResource( size_t chunk_size = VLLT_PAGE_CHUNK_SIZE ) noexcept : VlltPageResource{ { .m_huge_pages = true }, chunk_size } {}
+	};
+
+	/// \brief Page resource whose memory is bound to a NUMA node. Falls back to normal memory if binding is not possible.
+	class VlltNumaResource : public VlltPageResource {
+	public:
+		VlltNumaResource( int node, bool huge_pages = false, size_t chunk_size = VLLT_PAGE_CHUNK_SIZE ) noexcept 
+			: VlltPageResource{ { .m_huge_pages = huge_pages, .m_numa_node = node }, chunk_size } {}
+	};
+
+	/// \brief Page resource that touches new blocks in the thread allocating them, so they are placed on its NUMA node.
+	class VlltFirstTouchResource : public VlltPageResource {
+	public:
+		VlltFirstTouchResource( bool huge_pages = false, size_t chunk_size = VLLT_PAGE_CHUNK_SIZE ) noexcept 
+			: VlltPageResource{ { .m_huge_pages = huge_pages, .m_first_touch = true }, chunk_size } {}
+	};
+
+
+
+	//---------------------------------------------------------------------------------------------------
+	//Waiting
+
+	#ifndef VLLT_WAIT_SPINS
+		#define VLLT_WAIT_SPINS 16	///< A waiting thread first tries again this often right away
+	#endif
+
+	#ifndef VLLT_WAIT_PAUSES
+		#define VLLT_WAIT_PAUSES 64	///< then this often after a pause instruction
+	#endif
+
+	#ifndef VLLT_WAIT_YIELDS
+		#define VLLT_WAIT_YIELDS 16	///< then this often after yielding the core, then it sleeps in atomic::wait()
+	#endif
+
+	/// \brief Tell the core that this is a spin loop. This saves power and frees resources for the other hyperthread.
+	inline auto vllt_pause() noexcept -> void {
+		#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+			_mm_pause();
+		#elif defined(__aarch64__) || defined(__arm__)
+			asm volatile("yield");
+		#endif
+	}
+
+	/// \brief Wait policy for a thread that waits for another thread to change an atomic. Each call to wait() waits 
+	/// longer: first it returns right away VLLT_WAIT_SPINS times, then it pauses VLLT_WAIT_PAUSES times, then it yields 
+	/// VLLT_WAIT_YIELDS times, and from then on it sleeps in atomic::wait(). So short waits stay fast, and long waits 
+	/// do not burn cores if there are more threads than cores. The thread that changes the atomic must call notify_all().
+	class VlltBackoff {
+	public:
+		/// \brief Wait a bit for an atomic to change.
+		/// \param[in] atomic The atomic.
+		/// \param[in] old Last value of the atomic that was seen. Sleeping returns as soon as the atomic has another value.
+		template<typename T>
+		inline auto wait(std::atomic<T>& atomic, T old) noexcept -> void {
+			if( m_count < VLLT_WAIT_SPINS ) {}
+			else if( m_count < VLLT_WAIT_SPINS + VLLT_WAIT_PAUSES ) vllt_pause();
+			else if( m_count < VLLT_WAIT_SPINS + VLLT_WAIT_PAUSES + VLLT_WAIT_YIELDS ) std::this_thread::yield();
+			else atomic.wait(old);
+			++m_count;
+		}
+
+		/// \returns true if the next call to wait() might sleep, then the waiting thread must be announced to the notifying thread.
+		inline auto sleeping() const noexcept -> bool { return m_count >= VLLT_WAIT_SPINS + VLLT_WAIT_PAUSES + VLLT_WAIT_YIELDS; }
+
+	private:
+		size_t m_count{0}; ///< Number of calls to wait()
+	};
+
+
+
+	//---------------------------------------------------------------------------------------------------
+	//Column locks
+
+	#ifndef VLLT_NUMBER_OF_LOCK_SHARDS
+		#define VLLT_NUMBER_OF_LOCK_SHARDS 16
+	#endif
+
+	#ifndef VLLT_COLUMN_LOCK
+		#define VLLT_COLUMN_LOCK vllt::VlltBravoLock	///< Lock protecting a column of an internally synced table
+	#endif
+
+	/// \brief A lock for the columns of internally synced tables. Shared locks return a token that must be
+	/// given back when unlocking, so a lock can remember how a reader got in.
+	template<typename L>
+	concept VlltColumnLock = requires(L lock, size_t token) {
+		{ lock.lock() } -> std::same_as<void>;
+		{ lock.try_lock() } -> std::same_as<bool>;
+		{ lock.unlock() } -> std::same_as<void>;
+		{ lock.lock_shared() } -> std::same_as<size_t>;
+		{ lock.try_lock_shared(token) } -> std::same_as<bool>;
+		{ lock.unlock_shared(token) } -> std::same_as<void>;
+	};
+
+
+	/// \brief Column lock using std::shared_timed_mutex, padded to a cache line.
+	class alignas(64) VlltStdSharedMutex {
+	public:
+		inline auto lock() -> void { m_mutex.lock(); }
+		inline auto try_lock() -> bool { return m_mutex.try_lock(); }
+		inline auto unlock() -> void { m_mutex.unlock(); }
+		inline auto lock_shared() -> size_t { m_mutex.lock_shared(); return 0; }
+		inline auto try_lock_shared(size_t& token) -> bool { token = 0; return m_mutex.try_lock_shared(); }
+		inline auto unlock_shared([[maybe_unused]] size_t token) -> void { m_mutex.unlock_shared(); }
+
+	private:
+		std::shared_timed_mutex m_mutex;
+	};
+
+
+	/// \brief Reader-writer lock in one cache line padded atomic. Waiting writers block new readers, so writers do not starve.
+	/// The state counts the waiting writers, so new readers stay blocked until the last waiting writer got the lock.
+	/// Waiting threads block with atomic::wait().
+	class alignas(64) VlltRWLock {
+	public:
+		inline auto lock() noexcept -> void {
+			auto state = m_state.load();
+			bool waiting = false; //is this writer counted in WAITERS?
+			while(1) {
+				if( (state & (WRITER | READERS)) == 0 ) { 
+					if( m_state.compare_exchange_weak(state, (state | WRITER) - (waiting ? WAITER : 0)) ) return; 
+					continue; 
+				}
+				if( !waiting ) { //block new readers
+					assert( (state & WAITERS) != WAITERS );
+					if( !m_state.compare_exchange_weak(state, state + WAITER) ) continue; 
+					waiting = true;
+					state += WAITER;
+				}
+				m_state.wait(state);
+				state = m_state.load();
+			}
+		}
+
+		inline auto try_lock() noexcept -> bool {
+			auto state = m_state.load();
+			while( (state & (WRITER | READERS)) == 0 ) {
+				if( m_state.compare_exchange_weak(state, state | WRITER) ) return true;
+			}
+			return false;
+		}
+
+		inline auto unlock() noexcept -> void {
+			m_state.fetch_and(~WRITER);	//waiting writers stay counted, so readers cannot get in before them
+			m_state.notify_all();
+		}
+
+		inline auto lock_shared() noexcept -> size_t {
+			size_t token;
+			while( !try_lock_shared(token) ) {
+				auto state = m_state.load();
+				if( state & (WRITER | WAITERS) ) m_state.wait(state);
+			}
+			return token;
+		}
+
+		inline auto try_lock_shared(size_t& token) noexcept -> bool {
+			token = 0;
+			auto state = m_state.load();
+			while( !(state & (WRITER | WAITERS)) ) {
+				if( m_state.compare_exchange_weak(state, state + 1) ) return true;
+			}
+			return false;
+		}
+
+		inline auto unlock_shared([[maybe_unused]] size_t token) noexcept -> void {
+			auto state = m_state.fetch_sub(1) - 1;
+			if( (state & READERS) == 0 && (state & WAITERS) ) m_state.notify_all(); //last reader wakes up the writers
+		}
+
+	private:
+		static const uint32_t WRITER = 1u << 31;		///< A writer holds the lock
+		static const uint32_t WAITER = 1u << 22;		///< One waiting writer in WAITERS
+		static const uint32_t WAITERS = WRITER - WAITER;	///< Number of waiting writers, these block new readers
+		static const uint32_t READERS = WAITER - 1;		///< Number of readers holding the lock
+		std::atomic<uint32_t> m_state{0};
+	};
+
+
+	/// \brief Reader biased lock, following BRAVO (Dice and Kogan, 2019). While the lock is biased towards readers, 
+	/// a reader only increments one of VLLT_NUMBER_OF_LOCK_SHARDS counters, each in its own cache line, so readers do not 
+	/// write to a common cache line. A writer revokes the bias and waits until all counters are 0, then the lock 
+	/// works like VlltRWLock. Readers turn the bias on again after 9 times the time the last revocation took.
+	class alignas(64) VlltBravoLock {
+	public:
+		inline auto lock() noexcept -> void {
+			m_lock.lock();
+			if( m_rbias.load() ) revoke();
+		}
+
+		inline auto try_lock() noexcept -> bool {
+			if( !m_lock.try_lock() ) return false;
+			if( m_rbias.load() ) {
+				m_rbias.store(false);
+				for( auto& slot : m_slots ) {
+					if( slot.m_readers.load() != 0 ) { //there are fast readers, give up
+						m_rbias.store(true);
+						m_lock.unlock();
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		inline auto unlock() noexcept -> void { m_lock.unlock(); }
+
+		inline auto lock_shared() noexcept -> size_t {
+			size_t token;
+			if( try_lock_fast(token) ) return token;
+			m_lock.lock_shared();
+			bias();
+			return 0;
+		}
+
+		inline auto try_lock_shared(size_t& token) noexcept -> bool {
+			if( try_lock_fast(token) ) return true;
+			if( !m_lock.try_lock_shared(token) ) return false;
+			bias();
+			return true;
+		}
+
+		inline auto unlock_shared(size_t token) noexcept -> void {
+			if( token == 0 ) { m_lock.unlock_shared(token); return; }
+			auto& readers = m_slots[token - 1].m_readers;
+			readers.fetch_sub(1);
+			if( !m_rbias.load() ) readers.notify_all(); //a writer might wait for this counter
+		}
+
+	private:
+		static inline auto now() noexcept -> int64_t { 
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); 
+		}
+
+		/// \brief Fast path for readers, increment a counter and check whether the bias is still on.
+		/// \param[out] token Index of the counter + 1.
+		inline auto try_lock_fast(size_t& token) noexcept -> bool {
+			if( !m_rbias.load() ) return false;
+			thread_local const size_t slot = std::hash<std::thread::id>{}(std::this_thread::get_id()) % VLLT_NUMBER_OF_LOCK_SHARDS;
+			auto& readers = m_slots[slot].m_readers;
+			readers.fetch_add(1);
+			if( m_rbias.load() ) { token = slot + 1; return true; }
+			readers.fetch_sub(1);	//a writer revoked the bias
+			readers.notify_all();
+			return false;
+		}
+
+		/// \brief Called by readers holding the lock in the slow path. No writer holds the lock, so the bias can be turned on.
+		inline auto bias() noexcept -> void {
+			if( !m_rbias.load(std::memory_order_relaxed) && now() >= m_inhibit_until.load(std::memory_order_relaxed) ) m_rbias.store(true);
+		}
+
+		/// \brief Called by a writer holding the lock. Turn off the bias and wait for the fast readers to leave.
+		inline auto revoke() noexcept -> void {
+			auto start = now();
+			m_rbias.store(false);
+			for( auto& slot : m_slots ) {
+				for( auto readers = slot.m_readers.load(); readers != 0; readers = slot.m_readers.load() ) slot.m_readers.wait(readers);
+			}
+			auto end = now();
+			m_inhibit_until.store( end + 9 * (end - start), std::memory_order_relaxed );
+		}
+
+		struct alignas(64) slot_t {
+			std::atomic<uint32_t> m_readers{0};	///< Number of fast readers using this counter
+		};
+
+		std::atomic<bool> m_rbias{true};			///< If true, readers take the fast path
+		std::atomic<int64_t> m_inhibit_until{0};	///< Readers do not turn on the bias before this time
+		VlltRWLock m_lock;							///< Lock for writers and slow readers
+		std::array<slot_t, VLLT_NUMBER_OF_LOCK_SHARDS> m_slots; ///< Counters of fast readers
+	};
+
+
+	/// \brief List of coroutines waiting for column locks. Coroutines are not blocked, they are parked in the list and 
+	/// resumed by a thread that releases locks. The list itself is protected by a short spin lock.
+	class VlltWaitList {
+	public:
+		/// \brief A parked coroutine. try_acquire() tries to get all locks the coroutine waits for.
+		class waiter_t {
+		public:
+			virtual auto try_acquire() noexcept -> bool = 0; ///< \returns true if all locks could be acquired
+			std::coroutine_handle<> m_handle{}; ///< Coroutine to resume
+			waiter_t* m_next{nullptr}; ///< Next waiter in the list
+		};
+
+		/// \brief Park a waiter, unless it can acquire its locks now.
+		/// \param[in] waiter The waiter.
+		/// \returns true if the waiter was parked, false if it acquired its locks and must not be suspended.
+		inline auto park(waiter_t& waiter) noexcept -> bool {
+			lock();
+			m_size.fetch_add(1);	//releasing threads see the waiter before it tries again
+			if( waiter.try_acquire() ) {
+				m_size.fetch_sub(1);
+				unlock();
+				return false;
+			}
+			waiter.m_next = nullptr;
+			if( m_tail ) m_tail->m_next = &waiter; else m_head = &waiter;
+			m_tail = &waiter;
+			unlock();
+			return true;
+		}
+
+		/// \brief Called after releasing locks. Waiters that can acquire their locks now are removed and resumed in FIFO order.
+		/// A resumed coroutine releases locks itself and calls wake() again. Then its waiters are only queued, and resumed by the 
+		/// outermost call, so coroutines are never resumed recursively.
+		inline auto wake() noexcept -> void {
+			std::atomic_thread_fence(std::memory_order_seq_cst); //locks are released before the list is checked
+			if( m_size.load() == 0 ) return;
+
+			auto& [ready, ready_tail, resuming] = t_ready;
+			lock();
+			for( waiter_t* prev = nullptr, *waiter = m_head, *next; waiter; waiter = next ) {
+				next = waiter->m_next;
+				if( !waiter->try_acquire() ) { prev = waiter; continue; }
+				(prev ? prev->m_next : m_head) = next; //remove from the list
+				if( m_tail == waiter ) m_tail = prev;
+				m_size.fetch_sub(1);
+				waiter->m_next = nullptr;
+				if( ready_tail ) ready_tail->m_next = waiter; else ready = waiter;
+				ready_tail = waiter;
+			}
+			unlock();
+
+			if( resuming ) return;
+			resuming = true;
+			while( ready ) { //resume outside the lock, a coroutine might release locks itself
+				auto waiter = ready;
+				ready = waiter->m_next;
+				if( !ready ) ready_tail = nullptr;
+				waiter->m_handle.resume();
+			}
+			resuming = false;
+		}
+
+	private:
+		inline auto lock() noexcept -> void {
+			for( size_t i = 0; m_lock.test_and_set(std::memory_order_acquire); ++i ) { if( i >= 64 ) std::this_thread::yield(); }
+		}
+
+		inline auto unlock() noexcept -> void { m_lock.clear(std::memory_order_release); }
+
+		struct ready_t {
+			waiter_t* m_head; ///< First waiter to resume
+			waiter_t* m_tail; ///< Last waiter to resume
+			bool m_resuming; ///< Is this thread resuming waiters?
+		};
+		static inline thread_local ready_t t_ready{}; ///< Waiters that this thread has to resume
+
+		std::atomic_flag m_lock{}; ///< Protects the list
+		std::atomic<size_t> m_size{0}; ///< Number of parked waiters, so releasing threads do not touch the lock if there are none
+		waiter_t* m_head{nullptr}; ///< First waiter
+		waiter_t* m_tail{nullptr}; ///< Last waiter
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+	//Instrumentation
+
+	#ifndef VLLT_NUMBER_OF_STATS_SHARDS
+		#define VLLT_NUMBER_OF_STATS_SHARDS 16
+	#endif
+
+	/// \brief Snapshot of the counters of a table, returned by VlltStaticTable::stats().
+	struct VlltStats {
+		uint64_t m_push_cas_retries{0};	///< Failed CAS on the size counter while adding rows, also waiting for pops or earlier pushes
+		uint64_t m_pop_cas_retries{0};	///< Failed CAS on the size counter while removing rows, also waiting for pushes
+		uint64_t m_starving_waits{0};	///< FAIR: number of times a thread had to wait on m_starving
+		uint64_t m_map_grows{0};		///< Number of times resize() had to grow the block map, or help another thread growing it
+		uint64_t m_blocks_allocated{0};	///< Number of blocks allocated
+		uint64_t m_blocks_freed{0};		///< Number of blocks freed, including those freed by the destructor
+		uint64_t m_maps_allocated{0};	///< Number of block maps or segments allocated
+		uint64_t m_eliminations{0};		///< VlltStack: number of push/pop pairs that met in the elimination array and did not touch the table
+		uint64_t m_blocks_recycled{0};	///< Number of blocks taken from the block cache instead of the memory resource
+		std::array<uint64_t, VLLT_MAX_NUMBER_OF_COLUMNS> m_lock_wait_ns{};	///< Nanoseconds views waited for the lock of each column
+	};
+
+	/// \brief Counters of a table. Each thread adds to one of VLLT_NUMBER_OF_STATS_SHARDS shards, so that threads 
+	/// do not write to the same cache line. If ENABLED is false, there are no counters, and adding does nothing.
+	/// \tparam ENABLED If false, this class is empty.
+	template<bool ENABLED>
+	class VlltStatsCounters {
+	public:
+		enum counter_t : size_t { PUSH_CAS_RETRIES = 0, POP_CAS_RETRIES, STARVING_WAITS, MAP_GROWS, BLOCKS_ALLOCATED, BLOCKS_FREED, MAPS_ALLOCATED, ELIMINATIONS, BLOCKS_RECYCLED, LOCK_WAIT_NS };
+
+		/// \brief Add to a counter.
+		/// \param[in] counter Index of the counter, for column i use LOCK_WAIT_NS + i.
+		/// \param[in] n Value to add.
+		inline auto add([[maybe_unused]] size_t counter, [[maybe_unused]] uint64_t n = 1) noexcept -> void {
+			if constexpr (ENABLED) {
+				thread_local const size_t shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % VLLT_NUMBER_OF_STATS_SHARDS;
+				m_shards[shard].m_counters[counter].fetch_add(n, std::memory_order_relaxed);
+			}
+		}
+
+		/// \returns the sums of all shards. Counters are read one by one, so the snapshot is not atomic.
+		inline auto snapshot() const noexcept -> VlltStats {
+			std::array<uint64_t, NUM_COUNTERS> sum{};
+			if constexpr (ENABLED) {
+				for( auto& shard : m_shards ) {
+					for( size_t i = 0; i < NUM_COUNTERS; ++i ) sum[i] += shard.m_counters[i].load(std::memory_order_relaxed);
+				}
+			}
+			VlltStats stats{ sum[PUSH_CAS_RETRIES], sum[POP_CAS_RETRIES], sum[STARVING_WAITS], sum[MAP_GROWS], sum[BLOCKS_ALLOCATED], sum[BLOCKS_FREED], sum[MAPS_ALLOCATED], sum[ELIMINATIONS], sum[BLOCKS_RECYCLED] };
+			for( size_t i = 0; i < VLLT_MAX_NUMBER_OF_COLUMNS; ++i ) stats.m_lock_wait_ns[i] = sum[LOCK_WAIT_NS + i];
+			return stats;
+		}
+
+	private:
+		static const size_t NUM_COUNTERS = LOCK_WAIT_NS + VLLT_MAX_NUMBER_OF_COLUMNS;
+
+		struct alignas(64) shard_t {
+			std::array<std::atomic<uint64_t>, NUM_COUNTERS> m_counters{};
+		};
+
+		std::array<shard_t, ENABLED ? VLLT_NUMBER_OF_STATS_SHARDS : 0> m_shards; ///< No shards if disabled
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+
+	#ifndef VLLT_BLOCK_CACHE_SIZE
+		#define VLLT_BLOCK_CACHE_SIZE 4	///< Default max number of free blocks a table keeps for reuse, see the table constructor
+	#endif
+
 
 
 	/// VlltStaticTable is the base class for some classes, enabling management of tables that can be appended in parallel.
-	/// \tparam DATA Types of the table.
+	/// \tparam LAYOUT Types of the table. A type list in LAYOUT is a column group, its columns are stored interleaved, see VlltColumns.
 	/// \tparam SYNC Synchronization type for the table.
 	/// \tparam N0 Number of rows in a block.
 	/// \tparam ROW If true, then the table is row based, otherwise column based.
 	/// \tparam MINSLOTS Minimum number of slots in a block.
 	/// \tparam FAIR If true, then the table is fair, otherwise not.
-	template<typename DATA, sync_t SYNC = sync_t::VLLT_SYNC_EXTERNAL, size_t N0 = 1 << 5, bool ROW = false, size_t MINSLOTS = 16, bool FAIR = false>
-		requires VlltStaticTableConcept<DATA>
+	/// \tparam STORAGE Storage engine that manages the blocks of the table.
+	/// \tparam STATS If true, the table counts contention and allocations, see stats().
+	/// \tparam ALIGN Alignment of the columns of a block in bytes, e.g. 32 for AVX2. 0 uses the natural alignment of each column.
+	template<typename LAYOUT, sync_t SYNC = sync_t::VLLT_SYNC_EXTERNAL, size_t N0 = 1 << 5, bool ROW = false, size_t MINSLOTS = 16, bool FAIR = false, storage_t STORAGE = storage_t::VLLT_STORAGE_BLOCK_MAP, bool STATS = false, size_t ALIGN = 0>
+		requires VlltStaticTableConcept<LAYOUT>
 	class VlltStaticTable {
-
 	public:
-		template<typename U1, sync_t U2, size_t U3, bool U4, size_t U5, bool U6, typename U7, typename U8>
+		using DATA = VlltColumns<LAYOUT>; ///< Types of the columns, with column groups flattened
+		template<typename U1, sync_t U2, size_t U3, bool U4, size_t U5, bool U6, storage_t U7, bool U8, size_t U9, typename U10, typename U11>
 		friend class VlltStaticTableView;
 
-		template<typename U1, sync_t U2, size_t U3, bool U4, size_t U5, bool U6, typename U7, typename U8>
+		template<typename U1, sync_t U2, size_t U3, bool U4, size_t U5, bool U6, storage_t U7, bool U8, size_t U9, typename U10, typename U11>
 		friend class VlltStaticIterator;
 
+		template<typename U1, sync_t U2, size_t U3, bool U4, size_t U5, bool U6, storage_t U7, bool U8, size_t U9, typename U10>
+		friend class VlltOptimisticView;
+
+		template<typename VIEW>
+		friend class VlltViewAwaiter;
+
+		template<typename... VIEWS>
+		friend class VlltViewGroup;
+
+		template<typename U1, size_t U2, bool U3, size_t U4, bool U5, storage_t U6, bool U7>
+		friend class VlltStack;
+
 		using tuple_value_t = vtll::to_tuple<DATA>;	///< Tuple holding the entries as value
 		using tuple_ref_t = vtll::to_ref_tuple<DATA>; ///< Tuple holding refs to the entries	
 		using tuple_const_ref_t = vtll::to_const_ref_tuple<DATA>; ///< Tuple holding refs to the entries
 
 	protected:
-		static_assert(std::is_default_constructible_v<DATA>, "Your components are not default constructible!");
 		static_assert(vtll::size<DATA>::value > 0, "You need at least one component in your table!");
 
 		const size_t NUMBITS1 = 44; ///< Number of bits for the index of the first item in the stack
 		using block_idx_t = vsty::strong_type_t<uint64_t, vsty::counter<>>; ///< Strong integer type for indexing blocks, 0 to size map - 1
 
-		static const size_t N = vtll::smallest_pow2_leq_value< N0 >::value;	///< Force N to be power of 2
-		static const size_t L = vtll::index_largest_bit< std::integral_constant<size_t, N> >::value - 1; ///< Index of largest bit in N
-		static const size_t BIT_MASK = N - 1;	///< Bit mask to mask off lower bits to get index inside block
-
-		using array_tuple_t1 = std::array<tuple_value_t, N>;///< ROW: an array of tuples
-		using array_tuple_t2 = vtll::to_tuple<vtll::transform_size_t<DATA, std::array, N>>;	///< COLUMN: a tuple of arrays
+		static constexpr size_t N = vtll::smallest_pow2_leq_value< N0 >::value;	///< Force N to be power of 2
+		static constexpr size_t L = vtll::index_largest_bit< std::integral_constant<size_t, N> >::value - 1; ///< Index of largest bit in N
+		static constexpr size_t BIT_MASK = N - 1;	///< Bit mask to mask off lower bits to get index inside block
+		static constexpr size_t PUSH_N_MAX = 1 << 12; ///< Max number of rows reserved at once by one thread
+		static constexpr int64_t MAX_DIFF = 1ll << 18; ///< Max sum of concurrent reservations, the signed diff in m_size_cnt has 20 bits
+		static_assert(PUSH_N_MAX <= MAX_DIFF, "A single reservation must fit into the diff of the size counter!");
+		static_assert(STORAGE != storage_t::VLLT_STORAGE_VIRTUAL || VLLT_VIRTUAL_MAX_ROWS % N == 0, "VLLT_VIRTUAL_MAX_ROWS must be a multiple of the block size!");
+
+		using array_tuple_t1 = VlltStorage<tuple_value_t, N>;///< ROW: an array of tuples
+		template<typename T, size_t M> ///< COLUMN: storage of one column group of a block, aligned to ALIGN if this is larger than the natural alignment
+		using column_storage_t = VlltStorage<T, M, std::max(alignof(T), ALIGN)>;
+		using array_tuple_t2 = vtll::to_tuple<vtll::transform_size_t<VlltGroupRows<LAYOUT>, column_storage_t, N>>;	///< COLUMN: a tuple of aligned arrays, one per column group
 		using block_t = std::conditional_t<ROW, array_tuple_t1, array_tuple_t2>; ///< Memory layout of the table
 
-		using block_ptr_t = std::shared_ptr<block_t>; ///< Shared pointer to a block
+		static constexpr size_t NUM_GROUPS = vtll::size<LAYOUT>::value; ///< COLUMN: number of column groups, a column that is not in a group is a group of its own
+		static constexpr auto COLUMN_POS = []<size_t... Gs>(std::index_sequence<Gs...>) { ///< COLUMN: group of each column and its position in the group
+			std::array<std::pair<size_t, size_t>, vtll::size<DATA>::value> pos{};
+			size_t i = 0;
+			( [&]() { for( size_t p = 0; p < vtll::size<VlltGroup<vtll::Nth_type<LAYOUT, Gs>>>::value; ++p ) pos[i++] = { Gs, p }; }(), ... );
+			return pos;
+		}(std::make_index_sequence<NUM_GROUPS>{});
+		template<size_t I> 
+		static constexpr bool GROUPED = !ROW && vtll::size<VlltGroup<vtll::Nth_type<LAYOUT, COLUMN_POS[I].first>>>::value > 1; ///< Is column I interleaved with other columns?
+
+		using block_ptr_t = block_t*; ///< Raw pointer to a block, protected by epoch based reclamation
 		struct block_map_t {
-			std::pmr::vector<std::atomic<block_ptr_t>> m_blocks;	///< Vector of shared pointers to the blocks
+			std::pmr::vector<std::atomic<block_ptr_t>> m_blocks;	///< Vector of pointers to the blocks
+		};
+
+		//SEGMENTED: segment s holds S << s block pointers, so segments 0 to s hold S*(2^(s+1) - 1) block pointers together
+		using entry_t = std::atomic<block_ptr_t>; ///< Entry of a segment, pointer to a block
+		static constexpr size_t S = std::bit_ceil( std::max(MINSLOTS, (size_t)1) ); ///< Number of entries in the first segment
+		static constexpr size_t S_BITS = std::countr_zero(S); ///< Index of the bit of S
+		static constexpr size_t NUM_SEGMENTS = STORAGE == storage_t::VLLT_STORAGE_SEGMENTED ? 64 - S_BITS : 0; ///< Segments needed for all block indices
+		using directory_t = std::array<std::atomic<entry_t*>, NUM_SEGMENTS>; ///< Directory of segments, never grows
+
+		//APPEND_ONLY: slots are claimed with fetch_add, and rows are published by per block commit counters. These live in 
+		//a directory of geometrically growing segments like the SEGMENTED block pointers, segment s holds COMMIT_S << s counters
+		static constexpr bool APPEND_ONLY = VlltAppendOnly<SYNC>; ///< Rows are never removed
+		using commit_cnt_t = std::atomic<uint32_t>; ///< Number of committed rows in a block
+		static constexpr size_t COMMIT_S = 64; ///< Number of counters in the first segment
+		static constexpr size_t NUM_COMMIT_SEGMENTS = 64 - std::countr_zero(COMMIT_S); ///< Segments needed for all block indices
+		struct append_cnt_t {
+			alignas(64) std::atomic<size_t> m_next{0};		///< Next free slot, claimed with fetch_add
+			alignas(64) std::atomic<size_t> m_committed{0};	///< All rows before this are constructed, never decreases
+			std::array<std::atomic<commit_cnt_t*>, NUM_COMMIT_SEGMENTS> m_directory{}; ///< Segments of commit counters
 		};
 
+		//VIRTUAL: each column group is one array in a reserved range of virtual memory, a row based table has one array of tuples
+		static constexpr size_t NUM_VM_COLUMNS = STORAGE == storage_t::VLLT_STORAGE_VIRTUAL ? (ROW ? 1 : NUM_GROUPS) : 0; ///< One array per column group
+
 		using slot_size_t = vsty::strong_type_t<uint64_t, vsty::counter<>> ;
 		using size_cnt_t1 = vsty::strong_type_t<slot_size_t, vsty::counter<>> ;
 		using size_cnt_t2 = std::atomic<slot_size_t>;
 		using size_cnt_t = std::conditional_t< SYNC == sync_t::VLLT_SYNC_EXTERNAL, size_cnt_t1, size_cnt_t2 >; ///< Atomic size counter
-		using starving_t = std::atomic<uint64_t>; ///< Indicator for starving, use only for stack
+		using starving_t = std::atomic<int32_t>; ///< Indicator for starving, use only for stack
+		static constexpr int32_t STARVING_NONE = 0;		///< FAIR: pushes and pops can run
+		static constexpr int32_t STARVING_POPS = -1;	///< FAIR: pops are starving, so pushes wait
+		static constexpr int32_t STARVING_PUSHES = 1;	///< FAIR: pushes are starving, so pops wait
+		static constexpr int64_t SHRINKING = -(1ll << 18);	///< Diff of the size counter while shrink_to_fit() runs, pushes and pops wait
+		using stats_t = VlltStatsCounters<STATS>; ///< Counters, empty if STATS is false
 
 	public:
 		/// \brief Constructor of class VlltStaticTable
 		/// \param pmr Memory resource for allocating blocks
-		VlltStaticTable(std::pmr::memory_resource* pmr = std::pmr::new_delete_resource()) noexcept
-			: m_alloc{ pmr }, m_block_map{ nullptr } {
+		/// \param block_cache_size Maximal number of free blocks the table keeps for reuse, 0 turns the block cache off.
+		/// \throws std::bad_alloc VIRTUAL: if the address space for VLLT_VIRTUAL_MAX_ROWS rows could not be reserved.
+		VlltStaticTable(std::pmr::memory_resource* pmr = std::pmr::new_delete_resource(), size_t block_cache_size = VLLT_BLOCK_CACHE_SIZE) noexcept(STORAGE != storage_t::VLLT_STORAGE_VIRTUAL)
+			: m_alloc{ pmr }, m_block_map{ nullptr }, m_block_cache( STORAGE == storage_t::VLLT_STORAGE_VIRTUAL ? 0 : block_cache_size, pmr ) {
 			if(vtll::size<DATA>::value > VLLT_MAX_NUMBER_OF_COLUMNS) 
 				std::cout << "Number of table columns " 
 					<< vtll::size<DATA>::value << " is larger than VLLT_MAX_NUMBER_OF_COLUMNS " << VLLT_MAX_NUMBER_OF_COLUMNS 
 					<< ", increase VLLT_MAX_NUMBER_OF_COLUMNS to at least " << vtll::size<DATA>::value << "!" << std::endl;
+
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) {
+				bool reserved = true;
+				for_each_column( [&](std::byte*& base, size_t size) { 
+					base = VlltVirtualMemory::reserve(VLLT_VIRTUAL_MAX_ROWS * size); 
+					reserved = reserved && base;
+				});
+				if( !reserved ) { //the destructor does not run, so give back the columns that were reserved
+					for_each_column( [&](std::byte*& base, size_t size) { VlltVirtualMemory::release(base, VLLT_VIRTUAL_MAX_ROWS * size); } );
+					throw std::bad_alloc{}; //decrease VLLT_VIRTUAL_MAX_ROWS
+				}
+			}
 		};
 
+		/// \brief Destructor of class VlltStaticTable. Frees all blocks and the block map.
+		~VlltStaticTable() noexcept {
+			m_epoch.reclaim_all();
+			clear_block_cache();
+			if constexpr (!std::is_trivially_destructible_v<tuple_value_t>) { //destroy the remaining rows
+				for( table_index_t n{0}; n < size(); ++n ) destroy_row( get_block_ptr(n), n );
+			}
+			if constexpr (APPEND_ONLY) {
+				for( size_t seg = 0; seg < NUM_COMMIT_SEGMENTS; ++seg ) {
+					if( auto segment = m_append.m_directory[seg].load() ) m_alloc.template deallocate_object<commit_cnt_t>(segment, COMMIT_S << seg);
+				}
+			}
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) {
+				for_each_column( [&](std::byte*& base, size_t size) { VlltVirtualMemory::release(base, VLLT_VIRTUAL_MAX_ROWS * size); } );
+			} else if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+				for( size_t seg = 0; seg < NUM_SEGMENTS; ++seg ) {
+					auto segment = m_directory[seg].load();
+					if( !segment ) continue;
+					for( size_t i = 0; i < (S << seg); ++i ) { 
+						if( auto ptr = segment[i].load() ) delete_block(this, ptr);
+					}
+					m_alloc.template deallocate_object<entry_t>(segment, S << seg);
+				}
+			} else {
+				auto map_ptr{ m_block_map.load() };
+				if( !map_ptr ) return;
+				for( auto& block : map_ptr->m_blocks ) { 
+					if( auto ptr = unfrozen(block.load()) ) delete_block(this, ptr);
+				}
+				free_block_map(this, map_ptr);
+			}
+		}
+
 		/// Return the number of rows in the table.
 		/// \returns The number of rows in the table.
 		inline auto size() noexcept {
+			if constexpr (APPEND_ONLY) return table_index_t{ m_append.m_committed.load() };
 			auto size = m_size_cnt.load();
+			if( table_diff(size) == SHRINKING ) return table_size(size);
 			auto s1 = table_index_t{ table_size(size) + table_diff(size) };
 			auto s2 = table_size(size);
 			return std::min(s1, s2);
@@ -333,10 +1475,79 @@ namespace vllt {
 
 		/// Return a view to the table that writes to all types.
 		template<>
-		inline auto view<>() noexcept { return VlltStaticTableView<DATA, SYNC, N0, ROW, MINSLOTS, FAIR, vtll::tl<>, DATA>(*this); };
+		inline auto view<>() noexcept { return VlltStaticTableView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, vtll::tl<>, DATA>(*this); };
+
+		/// Type of the view returned by view<Ts...>()
+		template<typename... Ts>
+		using view_t = decltype( std::declval<VlltStaticTable&>().template view<Ts...>() );
+
+		/// \brief Return a view to the table if all its columns can be locked without waiting. 
+		/// Never blocks, also not in DEBUG modes.
+		/// \tparam ...Ts Types of the table the view accesses, like for view().
+		/// \returns the view, or std::nullopt if a column is locked by another view.
+		template<typename... Ts >
+		inline auto try_view() noexcept -> std::optional<view_t<Ts...>> {
+			typename view_t<Ts...>::tokens_t tokens{};
+			if( !view_t<Ts...>::try_lock(*this, tokens) ) {
+				m_waiters.wake(); //a failed try might have held a lock while parked coroutines were tested
+				return std::nullopt;
+			}
+			return std::optional<view_t<Ts...>>{ std::in_place, *this, std::adopt_lock, tokens };
+		}
+
+		/// \brief Return the specification of a view, for acquiring views on several tables at once with vllt::acquire().
+		/// \tparam ...Ts Types of the table the view accesses, like for view().
+		/// \returns the specification of the view.
+		template<typename... Ts >
+		inline auto spec() noexcept -> VlltViewSpec<view_t<Ts...>> { return { *this }; }
+
+		/// \brief Return an awaitable for a view, use co_await table.async_view<Ts...>() in a coroutine. If the columns are 
+		/// locked by other views, the coroutine is suspended without blocking the thread, and resumed when they are free.
+		/// \tparam ...Ts Types of the table the view accesses, like for view().
+		/// \returns an awaiter, co_await returns the view.
+		template<typename... Ts >
+		inline auto async_view() noexcept -> VlltViewAwaiter<view_t<Ts...>> { return { *this }; }
+
+		/// \brief Return a view that reads the given columns without locking them. Writers are never blocked by this view.
+		/// Only for internally synced tables and trivially copyable columns.
+		/// \tparam ...Ts Types of the columns the view reads.
+		/// \returns an optimistic view to the table.
+		template<typename... Ts>
+			requires (sizeof...(Ts) > 0 && vtll::has_all_types<DATA, vtll::tl<Ts...>>::value && VlltOptimisticReadable<vtll::tl<Ts...>>)
+		inline auto optimistic_view() noexcept {
+			static_assert(NUM_LOCKS > 0, "Optimistic views are only available for internally synced tables!");
+			return VlltOptimisticView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, vtll::tl<Ts...>>(*this);
+		}
 
 		friend bool operator==(const VlltStaticTable& lhs, const VlltStaticTable& rhs) noexcept { return &lhs == &rhs; }
 
+		/// \brief Return a snapshot of the counters of the table. All counters are 0 if STATS is false.
+		/// \returns a snapshot of the counters. The counters keep running, so the values can be slightly out of date.
+		inline auto stats() const noexcept -> VlltStats { return m_stats.snapshot(); }
+
+		/// \brief Number of objects that can be accessed through a span handed out by for_each_block(). The memory of a column 
+		/// is padded to the column alignment, so vectorized loops can process whole vectors up to this number without a remainder loop.
+		/// A virtual table has no padding behind its columns, there the number is limited to the rows whose pages are committed.
+		/// Objects behind the span are not constructed, and are overwritten by rows added later.
+		/// \param[in] span Span over rows of a column, as handed out by for_each_block().
+		/// \returns the number of objects in the padded memory of the span.
+		template<typename T, size_t E>
+		inline auto padded_size(std::span<T, E> span) const noexcept -> size_t {
+			constexpr size_t A = std::max(alignof(T), ALIGN);
+			size_t padded = (span.size() * sizeof(T) + A - 1) / A * A / sizeof(T);
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { return std::min( padded, m_num_committed.load() ); } //spans start at row 0
+			return padded;
+		}
+
+		/// \brief Allocate the block map and all blocks needed for n rows up front, so that adding rows does not
+		/// allocate memory. Reserved blocks are not freed when rows are removed.
+		/// \param[in] n Number of rows.
+		/// \param[in] pretouch If true, write to all pages of the new blocks in parallel, so that the OS maps them now.
+		inline auto reserve(size_t n, bool pretouch = false, VlltThreadPool* pool = nullptr) -> void;
+
+		/// \brief Free all blocks after the last row, including blocks allocated by reserve(), and empty the block cache.
+		inline auto shrink_to_fit() noexcept -> void;
+
 		/// \brief Return a vector with the types of the table.
 		/// \return a vector with the types of the table.
 		auto get_types() -> std::vector<const std::type_info*> {
@@ -351,88 +1562,362 @@ namespace vllt {
 		/// \param data Data for the new row.
 		/// \returns Index of the new row.
 		template<typename... Cs>
-			requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<DATA>>
+			requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<VlltColumns<LAYOUT>>>
 		inline auto push_back_p( Cs&&... data ) noexcept -> table_index_t;
+
+		template<typename... Args>
+			requires VlltConstructible<DATA, Args...>
+		inline auto emplace_back_p( Args&&... args ) noexcept -> table_index_t {
+			return push_back_n_p(1, [&](block_ptr_t block_ptr, table_index_t n) { construct_row(block_ptr, n, std::forward<Args>(args)...); });
+		}
+
+		template<typename F>
+		inline auto push_back_n_p( size_t num, F&& fill, bool try_once = false ) noexcept -> table_index_t; ///< Add num new rows, fill(block_ptr, n) constructs row n
+
+		inline auto reserve_slots( size_t num, bool try_once = false ) noexcept -> std::pair<table_index_t, size_t>; ///< Reserve slots for new rows
+		inline auto commit_slots( table_index_t first, size_t num ) noexcept -> void; ///< Commit num reserved slots after their rows have been constructed
+		inline auto get_commit_counter(size_t b) -> commit_cnt_t&; ///< APPEND_ONLY: \returns the commit counter of block b, allocates its segment if needed
+		inline auto advance_committed() noexcept -> void; ///< APPEND_ONLY: move the committed prefix over all completely constructed rows
+
+		/// \brief Construct the components of a row in place, using a recursive templated lambda. 
+		/// Component I is constructed from argument I.
+		template<typename... Args>
+		inline auto construct_row( block_ptr_t block_ptr, table_index_t n, Args&&... args ) noexcept -> void {
+			if constexpr (ROW) { std::construct_at( get_row_ptr(block_ptr, n), std::forward<Args>(args)... ); } //construct the whole tuple
+			else if constexpr (sizeof...(Args) == 0) { //value-initialize all components
+				vtll::static_for<size_t, 0, vtll::size<DATA>::value >( [&](auto i) { std::construct_at( get_component_ptr<i>(block_ptr, n) ); } );
+			}
+			else {
+				auto f = [&]<size_t I, typename T, typename... Ts>(auto && fun, T && arg, Ts&&... args) {
+					std::construct_at( get_component_ptr<I>(block_ptr, n), std::forward<T>(arg) ); //move, copy, or convert
+					if constexpr (sizeof...(args) > 0) { fun.template operator() < I + 1 > (fun, std::forward<Ts>(args)...); } //recurse
+				};
+				f.template operator() < 0 > (f, std::forward<Args>(args)...);
+			}
+		}
+
+		/// \brief Call the destructors of the components of a row. Does nothing for trivially destructible components.
+		inline auto destroy_row( block_ptr_t block_ptr, table_index_t n ) noexcept -> void {
+			if constexpr (ROW) { 
+				if constexpr (!std::is_trivially_destructible_v<tuple_value_t>) std::destroy_at( get_row_ptr(block_ptr, n) ); 
+			} else {
+				vtll::static_for<size_t, 0, vtll::size<DATA>::value >( [&](auto i) {
+					if constexpr (!std::is_trivially_destructible_v<vtll::Nth_type<DATA, i>>) std::destroy_at( get_component_ptr<i>(block_ptr, n) );
+				});
+			}
+		}
+
+		/// \brief Call the destructors of rows first to last-1, column by column and block by block. 
+		/// Does nothing at all if all components are trivially destructible.
+		inline auto destroy_rows( table_index_t first, table_index_t last ) noexcept -> void {
+			if constexpr (!std::is_trivially_destructible_v<tuple_value_t>) {
+				auto blocks = get_blocks();
+				for( auto n = first; n < last; ) {
+					auto block_ptr = blocks( (size_t)block_idx(n) );
+					auto num = std::min( (size_t)(block_idx(n) + 1) << L, (size_t)last ) - (size_t)n;
+					if constexpr (ROW) { std::destroy_n( get_row_ptr(block_ptr, n), num ); }
+					else {
+						vtll::static_for<size_t, 0, vtll::size<DATA>::value >( [&](auto i) {
+							if constexpr (!std::is_trivially_destructible_v<vtll::Nth_type<DATA, i>>) std::destroy_n( get_component_ptr<i>(block_ptr, n), num );
+						});
+					}
+					n = table_index_t{ n + num };
+				}
+			}
+		}
+
+		/// \brief Move or copy the components of a row into a tuple of values, before the row is removed.
+		inline auto move_row( block_ptr_t block_ptr, table_index_t n, auto& ret ) noexcept -> void {
+			vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
+				[&](auto i) {
+					using type = vtll::Nth_type<DATA, i>;
+					if		constexpr (std::is_move_assignable_v<type>) { std::get<i>(ret) = std::move(* (this->template get_component_ptr<i>(block_ptr, n)) ); }	//move
+					else if constexpr (std::is_copy_assignable_v<type>) { std::get<i>(ret) = *(this->template get_component_ptr<i>(block_ptr, n)); }		//copy
+					else if constexpr (vtll::is_atomic<type>::value) { std::get<i>(ret) = this->template get_component_ptr<i>(block_ptr, n)->load(); } 		//atomic
+				}
+			);
+		}
  
 		//-------------------------------------------------------------------------------------------
 		//read data
 
+		inline auto get_row_ptr(block_ptr_t block_ptr, table_index_t n) noexcept -> tuple_value_t* requires ROW { ///< Return a pointer to the row
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { return reinterpret_cast<tuple_value_t*>(m_columns[0]) + n.value(); }
+			else { return &(*block_ptr)[n & BIT_MASK]; }
+		}
+
 		template<size_t I, typename C = vtll::Nth_type<DATA, I>>  ///< Return a pointer to the component
 		inline auto get_component_ptr(block_ptr_t block_ptr, table_index_t n) noexcept -> C* {
-			if constexpr (ROW) { return &std::get<I>((*block_ptr)[n & BIT_MASK]); }
-			else { return &std::get<I>(*block_ptr)[n & BIT_MASK]; }
+			if constexpr (ROW) { return &std::get<I>(*get_row_ptr(block_ptr, n)); }
+			else {
+				constexpr size_t G = COLUMN_POS[I].first;
+				using row_t = vtll::Nth_type<VlltGroupRows<LAYOUT>, G>;
+				row_t* row_ptr;
+				if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { row_ptr = reinterpret_cast<row_t*>(m_columns[G]) + n.value(); } //no block indirection
+				else { row_ptr = &std::get<G>(*block_ptr)[n & BIT_MASK]; }
+				if constexpr (GROUPED<I>) { return row_ptr->template get<COLUMN_POS[I].second>(); }
+				else { return row_ptr; }
+			}
 		}
 
 		template<typename Ts>
-		inline auto get_ref_tuple(table_index_t n) noexcept -> vtll::to_ref_tuple<Ts>;	///< \returns a tuple with refs to all components
+		inline auto get_ref_tuple(block_ptr_t block_ptr, table_index_t n) noexcept -> vtll::to_ref_tuple<Ts>;	///< \returns a tuple with refs to all components
+
+		template<typename Ts>
+		inline auto get_ref_tuple(table_index_t n) noexcept -> vtll::to_ref_tuple<Ts> { return get_ref_tuple<Ts>(get_block_ptr(n), n); };	///< \returns a tuple with refs to all components
+
+		template<typename Ts>
+		inline auto get_const_ref_tuple(block_ptr_t block_ptr, table_index_t n) noexcept -> vtll::to_const_ref_tuple<Ts> { return get_ref_tuple<Ts>(block_ptr, n); };	///< \returns a tuple with refs to all components
 
 		template<typename Ts>
 		inline auto get_const_ref_tuple(table_index_t n) noexcept -> vtll::to_const_ref_tuple<Ts> { return get_ref_tuple<Ts>(n); };	///< \returns a tuple with refs to all components
 
+		static inline auto get_block_ptr(block_map_t* map_ptr, size_t b) noexcept -> block_ptr_t { ///< \returns a pointer to block b of a map
+			return unfrozen( map_ptr->m_blocks[b].load(std::memory_order_acquire) );
+		}
+
+		inline auto get_block_ptr(table_index_t n) noexcept -> block_ptr_t { ///< \returns a pointer to the block holding row n
+			return get_blocks()( (size_t)block_idx(n) );
+		}
+
+		/// \brief Return a function that maps the index of an existing block to a pointer to the block. The block map is loaded 
+		/// only once, so the function can be used for all blocks that existed when it was created.
+		inline auto get_blocks() noexcept {
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) {
+				return [block_ptr = virtual_block()]([[maybe_unused]] size_t b) noexcept -> block_ptr_t { return block_ptr; };
+			} else if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+				return [this](size_t b) noexcept -> block_ptr_t { 
+					auto [seg, off] = segment_idx(b);
+					return m_directory[seg].load(std::memory_order_acquire)[off].load(std::memory_order_acquire);
+				};
+			} else {
+				return [map_ptr = m_block_map.load(std::memory_order_acquire)](size_t b) noexcept -> block_ptr_t { return get_block_ptr(map_ptr, b); };
+			}
+		}
+
+		inline auto find_block(size_t b) noexcept -> block_ptr_t; ///< \returns a pointer to block b, or nullptr if there is no such block
+		inline auto remove_block(size_t b) noexcept -> block_ptr_t; ///< Remove block b from the table, \returns the removed block or nullptr
+
+		template<typename Ts>
+		inline auto get_span_tuple(block_ptr_t block_ptr, table_index_t first, size_t num) noexcept requires (!ROW) { ///< \returns a tuple with spans over num rows starting with row first
+			static_assert( []<size_t... Is>(std::index_sequence<Is...>) { return (!GROUPED< vtll::index_of<DATA, vtll::Nth_type<Ts,Is>>::value > && ...); }(std::make_index_sequence<vtll::size<Ts>::value>{})
+				, "Columns in a column group are interleaved, so there are no spans over them!" );
+			return [&] <size_t... Is>(std::index_sequence<Is...>) { 
+				return std::make_tuple( std::span<vtll::Nth_type<Ts,Is>>{ get_component_ptr< vtll::index_of<DATA, vtll::Nth_type<Ts,Is>>::value >(block_ptr, first), num }... ); 
+			} (std::make_index_sequence<vtll::size<Ts>::value>{});
+		}
+
+		template<typename Ts>
+		inline auto get_const_span_tuple(block_ptr_t block_ptr, table_index_t first, size_t num) noexcept requires (!ROW) { ///< \returns a tuple with const spans over num rows starting with row first
+			static_assert( []<size_t... Is>(std::index_sequence<Is...>) { return (!GROUPED< vtll::index_of<DATA, vtll::Nth_type<Ts,Is>>::value > && ...); }(std::make_index_sequence<vtll::size<Ts>::value>{})
+				, "Columns in a column group are interleaved, so there are no spans over them!" );
+			return [&] <size_t... Is>(std::index_sequence<Is...>) { 
+				return std::make_tuple( std::span<const vtll::Nth_type<Ts,Is>>{ get_component_ptr< vtll::index_of<DATA, vtll::Nth_type<Ts,Is>>::value >(block_ptr, first), num }... ); 
+			} (std::make_index_sequence<vtll::size<Ts>::value>{});
+		}
+
 		//-------------------------------------------------------------------------------------------
 		//erase data
 
-		inline auto pop_back(table_index_t* idx = nullptr) noexcept -> tuple_value_t; ///< Remove the last row, call destructor on components
+		inline auto pop_back(table_index_t* idx = nullptr, bool* contended = nullptr, size_t slot = VlltEpoch::NO_SLOT) noexcept -> tuple_value_t; ///< Remove the last row, call destructor on components
+		template<typename It = std::nullptr_t>
+		inline auto pop_back_n(size_t num, It out = nullptr) noexcept -> size_t; ///< Remove up to num rows from the back, move their values to out
+		inline auto truncate(size_t n) noexcept -> size_t; ///< Remove all rows from row n on, call destructors
 		inline auto clear() noexcept; ///< Set the number if rows to zero - effectively clear the table, call destructors
-		inline auto swap(auto src, auto dst) noexcept -> void;	///< Swap contents of two rows
-		inline auto swap(table_index_t isrc, table_index_t idst) noexcept -> void {swap( get_ref_tuple<DATA>(isrc), get_ref_tuple<DATA>(idst) );}	///< Swap contents of two rows
-		inline auto erase(table_index_t n1) -> tuple_value_t; ///< Remove a row, call destructor on components
+		inline auto swap(auto&& src, auto&& dst) noexcept -> void;	///< Swap contents of two tuples, values or refs to rows
+		inline auto swap(table_index_t isrc, table_index_t idst) noexcept -> void { begin_rows(); swap( get_ref_tuple<DATA>(isrc), get_ref_tuple<DATA>(idst) ); end_rows(); }	///< Swap contents of two rows
+		inline auto erase(table_index_t n1, size_t slot = VlltEpoch::NO_SLOT) -> tuple_value_t; ///< Remove a row, call destructor on components
+
+		template<typename F, typename It>
+		inline auto pop_back_range(F&& count, It out) noexcept -> size_t; ///< Remove count(rows) rows from the back with one CAS
 
 		//-------------------------------------------------------------------------------------------
 		//manage data
 
 		inline auto max_size() noexcept -> size_t {
+			if constexpr (APPEND_ONLY) return m_append.m_next.load();
 			auto size = m_size_cnt.load();
+			if( table_diff(size) == SHRINKING ) return (size_t)table_size(size);
 			return std::max(static_cast<decltype(table_size(size))>(table_size(size) + table_diff(size)), table_size(size));
 		}
 
 		static inline auto block_idx(table_index_t n) -> block_idx_t { return block_idx_t{ (n.value() >> L) }; }
-		inline auto resize(table_index_t slot) -> block_ptr_t; ///< If the map of blocks is too small, allocate a larger one and copy the previous block pointers into it.
+		inline auto resize(table_index_t slot, block_ptr_t block = nullptr) -> block_ptr_t; ///< Return the block for a slot, grow the map and allocate the block if needed.
+		inline auto grow_map(block_map_t* map_ptr, size_t idx) -> block_map_t*; ///< Replace the map of blocks with a larger one, copy the previous block pointers into it.
+		inline auto get_entry(size_t b) -> entry_t&; ///< SEGMENTED: \returns the entry of block b, allocates its segment if needed
+		inline auto commit(size_t num) -> void; ///< VIRTUAL: commit the pages of all columns for at least num rows
+
+		template<typename F>
+		inline auto for_each_column(F&& fun) -> void { ///< VIRTUAL: call fun(base pointer, size of an entry) for each column
+			if constexpr (ROW) { fun(m_columns[0], sizeof(tuple_value_t)); }
+			else { vtll::static_for<size_t, 0, NUM_GROUPS >( [&](auto i) { fun(m_columns[i], sizeof(vtll::Nth_type<VlltGroupRows<LAYOUT>, i>)); } ); }
+		}
+
+		/// VIRTUAL: rows are found without blocks, but pointers to blocks must not be nullptr, so use the first column for all blocks
+		inline auto virtual_block() noexcept -> block_ptr_t { return reinterpret_cast<block_ptr_t>(m_columns[0]); }
+
+		template<size_t B = S>
+		static inline auto segment_idx(size_t b) noexcept -> std::pair<size_t, size_t> { ///< SEGMENTED: \returns segment and offset of block b, if the first segment has B entries
+			size_t m = b + B;
+			size_t seg = (size_t)(63 - std::countl_zero(m)) - std::countr_zero(B);
+			return { seg, m - (B << seg) };
+		}
+
+		//While a map is being replaced, its entries are frozen by setting the lowest bit of the block pointers
+		static inline const block_ptr_t FROZEN = reinterpret_cast<block_ptr_t>(uintptr_t{1}); ///< A frozen entry without a block
+		static inline auto frozen(block_ptr_t ptr) noexcept -> block_ptr_t { return reinterpret_cast<block_ptr_t>(reinterpret_cast<uintptr_t>(ptr) | uintptr_t{1}); }
+		static inline auto unfrozen(block_ptr_t ptr) noexcept -> block_ptr_t { return reinterpret_cast<block_ptr_t>(reinterpret_cast<uintptr_t>(ptr) & ~uintptr_t{1}); }
+		static inline auto is_frozen(block_ptr_t ptr) noexcept -> bool { return (reinterpret_cast<uintptr_t>(ptr) & uintptr_t{1}) != 0; }
+
+		inline auto allocate_block() -> block_ptr_t { ///< Allocate a block, or take one from the block cache. Nothing is constructed in it
+			for( auto& entry : m_block_cache ) {
+				if( !entry.load(std::memory_order_relaxed) ) continue;
+				if( auto ptr = entry.exchange(nullptr) ) {
+					m_stats.add(stats_t::BLOCKS_RECYCLED);
+					return ptr;
+				}
+			}
+			m_stats.add(stats_t::BLOCKS_ALLOCATED);
+			return m_alloc.template new_object<block_t>(); 
+		}
+
+		/// \brief Put a block into the block cache, or free it if the cache is full. Used as free function for retired blocks.
+		static inline auto free_block(void* table, void* ptr) -> void {
+			auto self = static_cast<VlltStaticTable*>(table);
+			for( auto& entry : self->m_block_cache ) {
+				block_ptr_t empty = nullptr;
+				if( !entry.load(std::memory_order_relaxed) && entry.compare_exchange_strong(empty, static_cast<block_ptr_t>(ptr)) ) return;
+			}
+			delete_block(table, ptr);
+		}
+
+		static inline auto delete_block(void* table, void* ptr) -> void { ///< Give a block back to the memory resource
+			static_cast<VlltStaticTable*>(table)->m_stats.add(stats_t::BLOCKS_FREED);
+			static_cast<VlltStaticTable*>(table)->m_alloc.delete_object(static_cast<block_t*>(ptr));
+		}
+
+		inline auto clear_block_cache() noexcept -> void { ///< Free all blocks in the block cache
+			for( auto& entry : m_block_cache ) {
+				if( auto ptr = entry.exchange(nullptr) ) delete_block(this, ptr);
+			}
+		}
+
+		static inline auto free_block_map(void* table, void* ptr) -> void { ///< Free a block map, used as free function for retired maps
+			static_cast<VlltStaticTable*>(table)->m_alloc.delete_object(static_cast<block_map_t*>(ptr));
+		}
 
-		std::array<std::shared_timed_mutex, vtll::size<DATA>::value> m_access_mutex;
+		using column_lock_t = VLLT_COLUMN_LOCK; ///< Lock for a column
+		static_assert(VlltColumnLock<column_lock_t>, "VLLT_COLUMN_LOCK is not a column lock!");
+		static constexpr size_t NUM_LOCKS = (SYNC == sync_t::VLLT_SYNC_EXTERNAL || SYNC == sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK || SYNC == sync_t::VLLT_SYNC_EXTERNAL_APPEND_ONLY) ? 0 : vtll::size<DATA>::value;
+		std::array<column_lock_t, NUM_LOCKS> m_access_mutex; ///< One lock per column, only for internally synced tables
+
+		/// Version of a column or of the rows. The lower half counts the active writers, the upper half the finished writes.
+		/// Optimistic views read only while no writer is active, and compare the versions before and after reading.
+		struct alignas(64) version_t { 
+			std::atomic<uint64_t> m_value{0}; 
+		};
+		static const uint64_t VERSION_MUTATION = 1;					///< A push, pop, erase or swap that is running
+		static const uint64_t VERSION_VIEW = 1ull << 16;			///< A write view that handed out references to the column
+		static const uint64_t VERSION_WRITERS = (1ull << 32) - 1;	///< Active writers
+		static const uint64_t VERSION_ONE = 1ull << 32;				///< One finished write
+		std::array<version_t, NUM_LOCKS> m_column_version; ///< One version per column, only for internally synced tables
+		version_t m_row_version; ///< Version of the rows, changed when rows are added, removed or moved
+		VlltWaitList m_waiters; ///< Coroutines waiting for column locks
+
+		inline auto begin_write(version_t& version, uint64_t writer = VERSION_MUTATION) noexcept -> void { ///< Called before writing
+			version.m_value.fetch_add(writer, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release); //the active writer becomes visible before any write
+		}
+
+		inline auto end_write(version_t& version, uint64_t writer = VERSION_MUTATION) noexcept -> void { ///< Called after writing
+			version.m_value.fetch_add(VERSION_ONE - writer, std::memory_order_release);
+		}
+
+		inline auto begin_rows() noexcept -> void { if constexpr (NUM_LOCKS > 0) begin_write(m_row_version); } ///< Rows are added, removed or moved
+		inline auto end_rows() noexcept -> void { if constexpr (NUM_LOCKS > 0) end_write(m_row_version); } ///< Rows have been added, removed or moved
 		std::pmr::polymorphic_allocator<block_t> m_alloc; ///< Allocator for the table
 
-		alignas(64) std::atomic<std::shared_ptr<block_map_t>> m_block_map{nullptr};///< Atomic shared ptr to the map of blocks
+		alignas(64) std::atomic<block_map_t*> m_block_map{nullptr};///< Atomic pointer to the map of blocks
+		directory_t m_directory{}; ///< SEGMENTED: pointers to the segments, a segment is never moved or freed before the table
+		std::array<std::byte*, NUM_VM_COLUMNS> m_columns{}; ///< VIRTUAL: start of the reserved range of each column
+		std::atomic<size_t> m_num_committed{0}; ///< VIRTUAL: number of rows whose pages are committed in all columns
+		VlltEpoch m_epoch; ///< Protects blocks and block maps against being freed while they are accessed
+
+		/// \brief Wait until the size counter changes, see VlltBackoff. Threads that might sleep are counted, so that
+		/// notify_commit() has to wake up threads only if there are any.
+		/// \param[in] backoff Wait policy of the waiting thread.
+		/// \param[in] size Last value of the size counter.
+		inline auto wait_size([[maybe_unused]] VlltBackoff& backoff, [[maybe_unused]] slot_size_t size) noexcept -> void {
+			if constexpr (SYNC != sync_t::VLLT_SYNC_EXTERNAL) { //only one thread accesses externally synced tables
+				if( !backoff.sleeping() ) return backoff.wait(m_size_cnt, size);
+				m_size_waiters.fetch_add(1);
+				backoff.wait(m_size_cnt, size);
+				m_size_waiters.fetch_sub(1);
+			}
+		}
+
+		/// \brief Called after a push or pop has been committed. Wake up threads sleeping in wait_size(). 
+		/// In FAIR mode, if no other push or pop is running, let both run again.
+		/// \param[in] diff Diff of the size counter after the commit.
+		inline auto notify_commit([[maybe_unused]] int64_t diff) noexcept -> void {
+			if constexpr (SYNC != sync_t::VLLT_SYNC_EXTERNAL) {
+				if( m_size_waiters.load() > 0 ) m_size_cnt.notify_all();
+			}
+			if constexpr (FAIR) {
+				if( diff == 0 && m_starving.load() != STARVING_NONE ) { 
+					m_starving.store(STARVING_NONE); //allow pushes and pops again
+					m_starving.notify_all(); //notify all waiting threads
+				}
+			}
+		}
 
 		table_index_t table_size(slot_size_t size) { return table_index_t{ size.get_bits(0, NUMBITS1) }; }	
 		table_diff_t  table_diff(slot_size_t size) { return table_diff_t{ (int64_t)size.get_bits_signed(NUMBITS1) }; }
 		alignas(64) size_cnt_t m_size_cnt{ slot_size_t{ table_index_t{ 0 }, table_diff_t{0}, NUMBITS1 } };	///< Next slot and size as atomic
-		alignas(64) std::atomic<uint64_t> m_starving{0}; ///< prevent one operation to starve the other: -1...pulls are starving 1...pushes are starving
+		std::atomic<uint32_t> m_size_waiters{0}; ///< Number of threads that might sleep until m_size_cnt changes
+		alignas(64) starving_t m_starving{STARVING_NONE}; ///< prevent one operation to starve the other, see STARVING_POPS and STARVING_PUSHES
+		[[no_unique_address]] std::conditional_t<APPEND_ONLY, append_cnt_t, std::monostate> m_append; ///< APPEND_ONLY: slot counters and commit counters
+		std::atomic<size_t> m_num_reserved{0}; ///< Number of blocks allocated by reserve(), these are never freed by pop_back()
+		std::pmr::vector<std::atomic<block_ptr_t>> m_block_cache; ///< Free blocks for reuse, the size is set by the constructor
+		[[no_unique_address]] stats_t m_stats; ///< Counters, see stats()
 	};
 
 
 	/// \brief Create a view to the table.
 	/// \returns a view to the table.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
 	template<typename... Ts >
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::view() noexcept {
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::view() noexcept {
 		using parameters = vtll::tl<Ts...>;		///< List of types in the view
 
 		if constexpr (sizeof...(Ts) == 1 && std::is_same_v<vtll::front<parameters>, VlltWrite>) {
 			static_assert(VlltAllowOnlyPushback<SYNC>, "This table's SYNC option does not allow pushback-only views!");
-			return VlltStaticTableView<DATA, SYNC, N0, ROW, MINSLOTS, FAIR, vtll::tl<>, vtll::tl<VlltWrite>>(*this); ///< Create a pushback only view
+			return VlltStaticTableView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, vtll::tl<>, vtll::tl<VlltWrite>>(*this); ///< Create a pushback only view
+		} else if constexpr (std::is_same_v<parameters, vtll::tl<VlltWrite, VlltChunk>>) {
+			static_assert(VlltAllowOnlyPushback<SYNC>, "This table's SYNC option does not allow pushback-only views!");
+			return VlltStaticTableView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, vtll::tl<>, vtll::tl<VlltWrite, VlltChunk>>(*this); ///< Create a chunked pushback only view
 		} else {
 			static const size_t write = vtll::index_of<parameters, VlltWrite>::value; 		///< Index of VlltWrite in the view
-			static const bool write_valid = (write != std::numeric_limits<size_t>::max()); 	///< Is VlltWrite in the view?
+			static const bool write_valid = vtll::has_type<parameters, VlltWrite>::value; 	///< Is VlltWrite in the view? index_of does not return max() if it is not found
 
-			using read_list1 = typename std::conditional< sizeof...(Ts) == 0 || (write_valid && write == 0), vtll::tl<>, vtll::sublist<parameters, 0, write> >::type;
+			using read_list1 = typename std::conditional< sizeof...(Ts) == 0 || (write_valid && write == 0), vtll::tl<>, vtll::sublist<parameters, 0, write_valid ? write : sizeof...(Ts) - 1> >::type;
 			using read_list = vtll::remove_types< read_list1, vtll::tl<VlltWrite> >; //cannot use write - 1 if write == 0!
 
 			using write_list = typename std::conditional< sizeof...(Ts) == 0 	//if no types are given
 				|| !write_valid, vtll::tl<>, vtll::sublist<parameters, write + 1, sizeof...(Ts) - 1> >::type; //list of types with write access
 
-			return VlltStaticTableView<DATA, SYNC, N0, ROW, MINSLOTS, FAIR, read_list, write_list>(*this); ///< Create a view
+			return VlltStaticTableView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, read_list, write_list>(*this); ///< Create a view
 		}
 	}
 
 
 	/// \brief Get a tuple with references to components of an entry.
+	/// \param[in] block_ptr Pointer to the block holding the entry.
 	/// \param[in] n Index to the entry.
 	/// \returns a tuple with pointers to all components of entry n.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
 	template<typename Ts>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::get_ref_tuple(table_index_t n) noexcept -> vtll::to_ref_tuple<Ts> {
-		auto block_ptr = m_block_map.load()->m_blocks[(size_t)block_idx(n)].load();
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::get_ref_tuple(block_ptr_t block_ptr, table_index_t n) noexcept -> vtll::to_ref_tuple<Ts> {
 		return { [&] <size_t... Is>(std::index_sequence<Is...>) { 
 			return std::tie(*get_component_ptr< vtll::index_of<DATA, vtll::Nth_type<Ts,Is>>::value >(block_ptr, table_index_t{n})...); 
 		} (std::make_index_sequence<vtll::size<Ts>::value>{}) };
@@ -441,208 +1926,579 @@ namespace vllt {
 
 	/// Insert a new row at the end of the table. Make sure that there are enough blocks to store the new data.
 	/// If not allocate a new map to hold the segements, and allocate new blocks.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
 	template<typename... Cs>
-		requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<DATA>>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::push_back_p(Cs&&... data) noexcept -> table_index_t {
+		requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<VlltColumns<LAYOUT>>>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::push_back_p(Cs&&... data) noexcept -> table_index_t {
+		return push_back_n_p(1, [&](block_ptr_t block_ptr, table_index_t n) { construct_row(block_ptr, n, std::forward<Cs>(data)...); });
+	}
+
+
+	/// Insert num new rows at the end of the table. All slots are reserved with one CAS, then filled block by block,
+	/// and finally committed with one CAS. 
+	/// \param[in] num Number of new rows, at most PUSH_N_MAX.
+	/// \param[in] fill Function that is called as fill(block_ptr, n) for each new row n, and must construct all components of the row.
+	/// \param[in] try_once If true, give up instead of waiting if the size counter is contended. Then fill is never called.
+	/// \returns Index of the first new row, or an invalid index if try_once is true and the rows could not be reserved,
+	/// or if a VIRTUAL table has no room for num more rows below VLLT_VIRTUAL_MAX_ROWS.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	template<typename F>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::push_back_n_p(size_t num, F&& fill, bool try_once) noexcept -> table_index_t {
+		assert(num > 0 && num <= PUSH_N_MAX);
+
+		auto [first, reserved] = reserve_slots(num, try_once);
+		if( reserved == 0 ) return table_index_t{}; //contended and try_once, or a full VIRTUAL table
+
+		auto last = table_index_t{ first + num };
+		for( auto n = first; n < last; ) {
+			auto block_ptr = resize(n); //if need be, grow the map of blocks
+			auto block_last = table_index_t{ std::min( (size_t)(block_idx(n) + 1) << L, (size_t)last ) };
+			for( ; n < block_last; ++n ) fill(block_ptr, n);
+		}
+
+		commit_slots(first, num);
+		return first;	///< Return index of first new entry
+	}
+
+
+	/// \brief Reserve slots for new rows by increasing the diff of the size counter. This waits while rows are being popped,
+	/// and while the reservations of other threads leave less than num slots below MAX_DIFF, so the diff cannot overflow.
+	/// In FAIR mode, this also waits while pops are starving. VIRTUAL tables never reserve slots beyond VLLT_VIRTUAL_MAX_ROWS.
+	/// \param[in] num Number of slots to reserve, at most PUSH_N_MAX.
+	/// \param[in] try_once If true, give up instead of waiting if the size counter is contended.
+	/// \returns Index of the first reserved slot and the number of reserved slots, which is 0 if try_once is true and the slots could not be reserved,
+	/// or if a VIRTUAL table is full.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::reserve_slots(size_t num, bool try_once) noexcept -> std::pair<table_index_t, size_t> {
+		assert(num > 0 && num <= PUSH_N_MAX);
+
+		if constexpr (APPEND_ONLY && STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { //a CAS instead of fetch_add, so the table cannot overrun its range
+			auto next = m_append.m_next.load();
+			do {
+				if( next + num > VLLT_VIRTUAL_MAX_ROWS ) return { table_index_t{}, 0 };
+			} while( !m_append.m_next.compare_exchange_weak(next, next + num) );
+			return { table_index_t{ next }, num };
+		} else if constexpr (APPEND_ONLY) { //nothing is popped, so one fetch_add is enough
+			return { table_index_t{ m_append.m_next.fetch_add(num) }, num };
+		}
+
 		if constexpr (FAIR) {
-			if( m_starving.load()==-1 ) m_starving.wait(-1); //wait until pushes are done and pulls have a chance to catch up
-			if( table_diff(m_size_cnt.load()) < -4 ) m_starving.store(1); //if pops are starving the pushes, then prevent pulls 
+			if( m_starving.load() == STARVING_POPS ) { //wait until pushes are done and pulls have a chance to catch up
+				if( try_once ) return { table_index_t{}, 0 };
+				m_stats.add(stats_t::STARVING_WAITS);
+				VlltBackoff backoff;
+				for( auto starving = m_starving.load(); starving == STARVING_POPS; starving = m_starving.load() ) backoff.wait(m_starving, starving);
+			}
+			if( table_diff(m_size_cnt.load()) < -4 ) m_starving.store(STARVING_PUSHES); //if pops are starving the pushes, then prevent pulls 
 		}
 		
-		//increase size.m_diff to announce your demand for a new slot -> slot is now reserved for you
+		//increase size.m_diff to announce your demand for new slots -> slots are now reserved for you
+		VlltBackoff backoff;
 		slot_size_t size = m_size_cnt.load();	///< Make sure that no other thread is popping currently
-		while (table_diff(size) < 0 || !m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size), table_diff(size) + 1, NUMBITS1 } )) {
-			if ( table_diff(size)  < 0 ) { //here compare_exchange_weak was NOT called to copy manually
+		auto blocked = [&](slot_size_t size) { return table_diff(size) < 0 || table_diff(size) + (int64_t)num > MAX_DIFF; };
+		auto full = [&](slot_size_t size) { return STORAGE == storage_t::VLLT_STORAGE_VIRTUAL && (size_t)table_size(size) + table_diff(size) + num > VLLT_VIRTUAL_MAX_ROWS; };
+		while (full(size) || blocked(size) || !m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size), table_diff(size) + (int64_t)num, NUMBITS1 } )) {
+			if( full(size) ) return { table_index_t{}, 0 }; //the reserved range of a VIRTUAL table is used up
+			m_stats.add(stats_t::PUSH_CAS_RETRIES);
+			if( try_once ) return { table_index_t{}, 0 };
+			if ( blocked(size) ) { //here compare_exchange_weak was NOT called to copy manually
+				wait_size(backoff, size); //pops or too many pushes are running, they notify when they are committed
 				size = m_size_cnt.load();
 			}
-			//call wait() here
 		};
 
-		auto n = (table_index_t{table_size(size) + table_diff(size)}); ///< Get the index of the new row
-		auto block_ptr = resize(n); //if need be, grow the map of blocks
+		return { table_index_t{table_size(size) + table_diff(size)}, num };
+	}
 
-		//copy or move the data to the new slot, using a recursive templated lambda
-		auto f = [&]<size_t I, typename T, typename... Ts>(auto && fun, T && dat, Ts&&... dats) {
-			if constexpr (vtll::is_atomic<T>::value) get_component_ptr<I>(block_ptr, n)->store(dat); //copy value for atomic
-			else *get_component_ptr<I>(block_ptr, n) = std::forward<T>(dat); //move or copy
-			if constexpr (sizeof...(dats) > 0) { fun.template operator() < I + 1 > (fun, std::forward<Ts>(dats)...); } //recurse
-		};
-		f.template operator() < 0 > (f, std::forward<Cs>(data)...);
 
-		slot_size_t new_size = slot_size_t{ table_size(size), table_diff(size) + 1, NUMBITS1 };	///< Increase size to validate the new row
-		while (!m_size_cnt.compare_exchange_weak(new_size, slot_size_t{ table_size(new_size) + 1, table_diff(new_size) - 1, NUMBITS1 } ));
-		
-		if constexpr (FAIR) {
-			if(table_diff(new_size) - 1 == 0) { 
-				m_starving.store(0); //allow pushes again
-				m_starving.notify_all(); //notify all waiting threads
+	/// \brief Commit slots reserved by reserve_slots(), after their rows have been constructed. 
+	/// This moves num from the diff to the size of the size counter. Since size() must only cover constructed rows, slots
+	/// are committed in the order they were reserved, so this waits until all slots before first are committed. 
+	/// APPEND_ONLY tables add to the commit counters of the blocks instead, and then advance the committed prefix.
+	/// \param[in] first First slot to commit.
+	/// \param[in] num Number of slots to commit.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::commit_slots(table_index_t first, size_t num) noexcept -> void {
+		if constexpr (APPEND_ONLY) {
+			begin_rows();
+			for( size_t n = first, last = first + num; n < last; ) {
+				size_t block_last = std::min( ((n >> L) + 1) << L, last );
+				get_commit_counter(n >> L).fetch_add( (uint32_t)(block_last - n) );
+				n = block_last;
 			}
+			advance_committed();
+			end_rows();
+			return;
 		}
-		
-		return table_index_t{ table_size(size) + table_diff(size) };	///< Return index of new entry
+
+		VlltBackoff backoff;
+		slot_size_t size = m_size_cnt.load();
+		while( table_size(size) != first ) { //an earlier push is still constructing its rows, they notify when they are committed
+			m_stats.add(stats_t::PUSH_CAS_RETRIES);
+			wait_size(backoff, size);
+			size = m_size_cnt.load();
+		}
+
+		begin_rows(); ///< Increase size to validate the new rows
+		while (!m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size) + num, table_diff(size) - (int64_t)num, NUMBITS1 } )) {
+			m_stats.add(stats_t::PUSH_CAS_RETRIES);
+		}
+		end_rows();
+		notify_commit(table_diff(size) - (int64_t)num);
+	}
+
+
+	/// \brief Return the commit counter of a block. If the segment of the counter does not exist yet, allocate it 
+	/// and install it with one CAS. If another thread was faster, use its segment.
+	/// \param[in] b Index of the block.
+	/// \returns Reference to the counter of committed rows in the block.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::get_commit_counter(size_t b) -> commit_cnt_t& {
+		auto [seg, off] = segment_idx<COMMIT_S>(b);
+		auto segment = m_append.m_directory[seg].load();
+		if( !segment ) {
+			m_stats.add(stats_t::MAPS_ALLOCATED);
+			auto new_segment = m_alloc.template allocate_object<commit_cnt_t>(COMMIT_S << seg);
+			std::uninitialized_fill_n(new_segment, COMMIT_S << seg, 0);
+			if( m_append.m_directory[seg].compare_exchange_strong(segment, new_segment) ) segment = new_segment;
+			else m_alloc.template deallocate_object<commit_cnt_t>(new_segment, COMMIT_S << seg); //another thread was faster
+		}
+		return segment[off];
 	}
 
 
-	/// \brief If the map of blocks is too small, allocate a larger one and copy the previous block pointers into it.
-	/// Then make one CAS attempt. If the attempt succeeds, then remember the new block map.
-	/// If the CAS fails because another thread beat us, then CAS will copy the new pointer so we can use it.
+	/// \brief Move the committed prefix over all rows that are constructed. The prefix can move into the block b it points to
+	/// if the commit counter of b equals the number of claimed slots in b. Then all claimed slots of b are committed, 
+	/// since committed rows are always below the next free slot. Every thread calls this after committing, so the thread
+	/// that commits the last missing row of a block moves the prefix over it. No thread waits for another one.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::advance_committed() noexcept -> void {
+		size_t committed = m_append.m_committed.load();
+		while(1) {
+			size_t first = (committed >> L) << L; ///< First slot of the block of the prefix
+			size_t count = get_commit_counter(committed >> L).load(); //read the counter before the next free slot
+			size_t next = m_append.m_next.load();
+			size_t claimed = next > first ? std::min(next - first, N) : 0;
+			if( count != claimed || first + count <= committed ) return; //rows are missing, or nothing new
+			if( m_append.m_committed.compare_exchange_weak(committed, first + count) ) committed = first + count;
+		}
+	}
+
+
+	/// \brief Return the block holding a slot. If the map of blocks is too small, grow it first. If the block is missing, 
+	/// install a new block with one CAS. If the CAS fails because another thread was faster, use its block.
+	/// If the map is frozen because another thread is growing it, help growing and try again. No locks are used.
 	/// \param[in] slot Slot number in the table.
-	/// \returnss Pointer to the block map.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::resize(table_index_t slot) -> block_ptr_t {
-		static std::mutex m;
+	/// \param[in] block Block to install if there is no block for the slot yet. If nullptr, a new block is allocated.
+	/// \returns Pointer to the block holding the slot. If this is not block, then the caller still owns block.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::resize(table_index_t slot, block_ptr_t block) -> block_ptr_t {
+		auto idx = (size_t)block_idx(slot);
+		block_ptr_t new_block = nullptr; ///< Block allocated here
+
+		if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { //reserve_slots() keeps slot below VLLT_VIRTUAL_MAX_ROWS
+			try { commit( (idx + 1) << L ); } 
+			catch( ... ) { std::terminate(); } //pushes are noexcept, and their slots are already reserved
+			return virtual_block();
+		} else if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+			auto& entry = get_entry(idx);
+			auto ptr = entry.load();
+			if( ptr ) return ptr;
+			new_block = block ? block : allocate_block();
+			if( entry.compare_exchange_strong(ptr, new_block) ) return new_block;
+			if( new_block != block ) free_block(this, new_block); //another thread was faster
+			return ptr;
+		}
 
-		//Get a pointer to the block map. If there is none, then allocate a new one.
 		auto map_ptr{ m_block_map.load() };
-		if (!map_ptr) {
-			std::scoped_lock lock(m);
-			map_ptr = m_block_map.load();
-			if( !map_ptr ) {
-				map_ptr = std::allocate_shared<block_map_t>( //map has always as many MINSLOTS as its capacity is -> size==capacity
-					m_alloc, block_map_t{ std::pmr::vector<std::atomic<block_ptr_t>>{MINSLOTS, m_alloc} } //create a new map
-				);
-				m_block_map.store( map_ptr );
+
+		block_ptr_t ptr = nullptr;
+		while(1) {
+			if( !map_ptr || idx >= map_ptr->m_blocks.size() ) { //map is missing or too small
+				m_stats.add(stats_t::MAP_GROWS);
+				map_ptr = grow_map(map_ptr, idx);
+				continue;
 			}
+
+			ptr = map_ptr->m_blocks[idx].load();
+			if( ptr == FROZEN ) {	//map is being replaced, but the block is missing -> help growing
+				m_stats.add(stats_t::MAP_GROWS);
+				map_ptr = grow_map(map_ptr, map_ptr->m_blocks.size());
+				continue;
+			}
+			if( ptr ) break;	//block is already there, also if the map is frozen
+
+			if( !new_block ) new_block = block ? block : allocate_block(); //get a new block
+			if( map_ptr->m_blocks[idx].compare_exchange_strong(ptr, new_block) ) return new_block; //installed our block
+			if( ptr == FROZEN ) continue; //try again, the CAS loaded FROZEN into ptr
+			break;	//another thread was faster
 		}
 
-		assert(map_ptr != nullptr); ///< Make sure that the block map is there
+		if( new_block && new_block != block ) free_block(this, new_block); //our block is not needed
+		return unfrozen(ptr);
+	}
 
-		//Make sure that there is enough space in the block map so that blocks are there to hold the new slot.
-		//Because other threads might also do this, we need to run in a loop until we are sure that the new slot is covered.
-		auto idx = block_idx(slot);
 
-		while(1) {
-			if ( idx < map_ptr->m_blocks.size() ) {	//test if the block is already there
-				auto ptr = map_ptr->m_blocks[(size_t)idx].load();
-				if( ptr ) return ptr;	  //yes -> return
+	/// \brief Replace the map of blocks with a map that has at least idx + 1 slots. The entries of the old map are frozen first,
+	/// so no thread can install or remove a block in the old map after it has been copied. Then the entries are copied 
+	/// into the new map, and the new map is installed with one CAS. If the CAS fails, another thread was faster.
+	/// \param[in] map_ptr Map that is too small or frozen, or nullptr if there is no map yet.
+	/// \param[in] idx Index of the block that must fit into the new map.
+	/// \returns Pointer to the current map of blocks.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::grow_map(block_map_t* map_ptr, size_t idx) -> block_map_t* {
+		auto current = m_block_map.load();
+		if( current != map_ptr ) return current; //another thread already replaced the map
+
+		size_t num_blocks = map_ptr ? map_ptr->m_blocks.size() : 0;
+		size_t new_size = std::max( num_blocks, std::max(MINSLOTS, (size_t)1) );
+		while( idx >= new_size ) new_size <<= 1; //double the size of the map until the block fits
+
+		m_stats.add(stats_t::MAPS_ALLOCATED);
+		auto new_map_ptr = m_alloc.template new_object<block_map_t>( //map has always as many slots as its capacity is -> size==capacity
+			block_map_t{ std::pmr::vector<std::atomic<block_ptr_t>>{new_size, m_alloc} } 
+		);
 
-				std::scoped_lock lock(m);
-				ptr = map_ptr->m_blocks[(size_t)idx].load();
-				if( ptr ) return ptr;	  //yes -> return
-				map_ptr->m_blocks[(size_t)idx].store( std::allocate_shared<block_t>(m_alloc) ); //no -> get a new block
-				return map_ptr->m_blocks[(size_t)idx].load();
-			}
+		//Freeze the old entries, then copy the old block pointers into the new map. Missing blocks are allocated when they are needed.
+		for( size_t i = 0; i < num_blocks; ++i ) {
+			auto ptr = map_ptr->m_blocks[i].load();
+			while( !is_frozen(ptr) && !map_ptr->m_blocks[i].compare_exchange_weak(ptr, frozen(ptr)) );
+			new_map_ptr->m_blocks[i].store( unfrozen(ptr) );
+		}
 
-			std::scoped_lock lock(m);
+		if( m_block_map.compare_exchange_strong(current, new_map_ptr) ) {
+			if( map_ptr ) m_epoch.retire(this, map_ptr, free_block_map); //threads might still read the old map, free it later
+			return new_map_ptr;
+		}
+		free_block_map(this, new_map_ptr);	//another thread was faster, new map was never seen by others
+		return current;
+	}
 
-			map_ptr =  m_block_map.load();
-			if( idx < map_ptr->m_blocks.size() ) {
-				continue;	//another thread increased the size of the map, but the block might not be there, so test again
-			}
 
-			//Allocate a new block map and populate it with empty semgement pointers.
-			auto num_blocks = map_ptr->m_blocks.size();
-			auto new_size = num_blocks << 2; //double the size of the map
-			while( idx >= new_size ) new_size <<= 2; //make sure there are enough slots for the new block
+	/// \brief Return the entry of a block in the directory. If the segment of the entry does not exist yet,
+	/// allocate it and install it with one CAS. If another thread was faster, use its segment. Existing segments are never copied.
+	/// \param[in] b Index of the block.
+	/// \returns Reference to the entry holding the pointer to the block.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::get_entry(size_t b) -> entry_t& {
+		auto [seg, off] = segment_idx(b);
+		auto segment = m_directory[seg].load();
+		if( !segment ) {
+			m_stats.add(stats_t::MAPS_ALLOCATED);
+			auto new_segment = m_alloc.template allocate_object<entry_t>(S << seg);
+			std::uninitialized_fill_n(new_segment, S << seg, nullptr);
+			if( m_directory[seg].compare_exchange_strong(segment, new_segment) ) segment = new_segment;
+			else m_alloc.template deallocate_object<entry_t>(new_segment, S << seg); //another thread was faster
+		}
+		return segment[off];
+	}
+
+
+	/// \brief Commit the pages of all columns for at least num rows. At least doubles the number of committed rows, 
+	/// to keep the number of system calls small. Several threads can commit at the same time, since committing a page
+	/// twice is allowed. The new number of rows is published only after the pages have been committed.
+	/// \param[in] num Number of rows that must be accessible.
+	/// \throws std::length_error if num is larger than VLLT_VIRTUAL_MAX_ROWS.
+	/// \throws std::bad_alloc if the OS could not commit the pages.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::commit(size_t num) -> void {
+		auto num_committed = m_num_committed.load();
+		if( num <= num_committed ) return;
+		if( num > VLLT_VIRTUAL_MAX_ROWS ) throw std::length_error{ "VlltStaticTable: more rows than VLLT_VIRTUAL_MAX_ROWS" };
+		size_t new_num = std::min( std::max(num, 2 * num_committed), (size_t)VLLT_VIRTUAL_MAX_ROWS );
+		bool committed = true;
+		for_each_column( [&](std::byte*& base, size_t size) { 
+			committed = committed && VlltVirtualMemory::commit(base, num_committed * size, new_num * size); 
+		});
+		if( !committed ) throw std::bad_alloc{};
+		while( num_committed < new_num && !m_num_committed.compare_exchange_weak(num_committed, new_num) );
+	}
+
+
+	/// \brief Find a block without creating it.
+	/// \param[in] b Index of the block.
+	/// \returns Pointer to the block, or nullptr if the block does not exist.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::find_block(size_t b) noexcept -> block_ptr_t {
+		if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) {
+			return ((b + 1) << L) <= m_num_committed.load() ? virtual_block() : nullptr;
+		} else if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+			auto [seg, off] = segment_idx(b);
+			auto segment = m_directory[seg].load();
+			return segment ? segment[off].load() : nullptr;
+		} else {
+			auto map_ptr{ m_block_map.load() };
+			return map_ptr && b < map_ptr->m_blocks.size() ? get_block_ptr(map_ptr, b) : nullptr;
+		}
+	}
 
-			auto new_map_ptr = std::allocate_shared<block_map_t>( //map has always as many slots as its capacity is -> size==capacity
-				m_alloc, block_map_t{ std::pmr::vector<std::atomic<block_ptr_t>>{new_size, m_alloc} } //increase existing one
-			);
 
-			//Copy the old block pointers into the new map. 
-			for( size_t i = 0; i < num_blocks; ++i ) {
-				auto ptr = map_ptr->m_blocks[i].load();
-				if( ptr ) new_map_ptr->m_blocks[i].store( ptr );
-				else new_map_ptr->m_blocks[i].store( std::allocate_shared<block_t>(m_alloc) ); //get a new block
+	/// \brief Remove a block from the table with one CAS. The caller must retire the block.
+	/// If the block map is frozen because it is growing, the block is kept. Committed pages of a virtual table are kept as well.
+	/// \param[in] b Index of the block.
+	/// \returns Pointer to the removed block, or nullptr if no block was removed.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::remove_block(size_t b) noexcept -> block_ptr_t {
+		entry_t* entry = nullptr;
+		if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) {
+			return nullptr;
+		} else if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+			auto [seg, off] = segment_idx(b);
+			auto segment = m_directory[seg].load();
+			if( !segment ) return nullptr;
+			entry = &segment[off];
+		} else {
+			auto map_ptr{ m_block_map.load() };
+			if( !map_ptr || b >= map_ptr->m_blocks.size() ) return nullptr;
+			entry = &map_ptr->m_blocks[b];
+		}
+		auto ptr = entry->load();
+		if( ptr && !is_frozen(ptr) && entry->compare_exchange_strong(ptr, nullptr) ) return ptr;
+		return nullptr;
+	}
+
+
+
+	/// \brief Allocate the block map and all blocks needed for n rows up front. New blocks are touched before they are
+	/// installed, since other threads might already add rows to them afterwards.
+	/// \param[in] n Number of rows.
+	/// \param[in] pretouch If true, write to all pages of the new blocks, so that the OS maps them now.
+	/// \param[in] pool If not nullptr, the pages are touched by the threads of this pool, otherwise by the calling thread.
+	/// \throws std::length_error, std::bad_alloc VIRTUAL: see commit().
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::reserve(size_t n, bool pretouch, VlltThreadPool* pool) -> void {
+		if( n == 0 ) return;
+		size_t num_blocks = (size_t)block_idx(table_index_t{ n - 1 }) + 1;
+
+		if constexpr (STORAGE == storage_t::VLLT_STORAGE_VIRTUAL) { //commit the pages, rows might already be added to them afterwards
+			commit( num_blocks << L );
+			if( pretouch ) for_each_column( [&](std::byte*& base, size_t size) { VlltVirtualMemory::populate(base, (num_blocks << L) * size); } );
+			return;
+		}
+
+		//publish the reservation first, so a concurrent pop does not remove blocks that have just been installed
+		for( auto num = m_num_reserved.load(); num < num_blocks && !m_num_reserved.compare_exchange_weak(num, num_blocks); );
+
+		std::vector<std::pair<size_t, block_ptr_t>> blocks; //blocks that are still missing
+		for( size_t b = 0; b < num_blocks; ++b ) {
+			if( !find_block(b) ) blocks.emplace_back( b, allocate_block() );
+		}
+
+		if( pretouch && !blocks.empty() ) {
+			static const size_t PAGE_SIZE = VlltVirtualMemory::page_size();
+			auto touch = [&](size_t i) {
+				auto bytes = reinterpret_cast<volatile std::byte*>( blocks[i].second );
+				for( size_t j = 0; j < sizeof(block_t); j += PAGE_SIZE ) bytes[j] = std::byte{0};
+			};
+			if( pool ) pool->parallel_for( blocks.size(), touch );
+			else for( size_t i = 0; i < blocks.size(); ++i ) touch(i);
+		}
+
+		for( auto& [b, block] : blocks ) { //resize() also grows the map if needed
+			if( resize( table_index_t{ b << L }, block ) != block ) free_block(this, block); //another thread was faster
+		}
+	}
+
+
+	/// \brief Free all blocks after the block holding the last row, and all blocks in the block cache. When no push or pop 
+	/// is running, the diff of the size counter is set to SHRINKING, so pushes and pops wait until the blocks are removed. 
+	/// Committed pages of a virtual table are kept.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::shrink_to_fit() noexcept -> void {
+		if constexpr (STORAGE != storage_t::VLLT_STORAGE_VIRTUAL && !APPEND_ONLY) {
+			VlltBackoff backoff;
+			slot_size_t size = m_size_cnt.load();
+			while (table_diff(size) != 0 || !m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size), table_diff_t{SHRINKING}, NUMBITS1 })) {
+				if (table_diff(size) != 0) { //pushes or pops are running, they notify when they are committed
+					wait_size(backoff, size);
+					size = m_size_cnt.load(); 
+				}
 			}
-			for( size_t i = num_blocks; i <= idx; ++i ) {
-				new_map_ptr->m_blocks[i].store( std::allocate_shared<block_t>(m_alloc) ); //get a new block
+
+			size_t num_blocks = table_size(size) == 0 ? 0 : (size_t)block_idx( table_index_t{ table_size(size) - 1 } ) + 1;
+			auto remove = [&](size_t b) { if( auto ptr = remove_block(b) ) m_epoch.retire(this, ptr, delete_block); };
+			if constexpr (STORAGE == storage_t::VLLT_STORAGE_SEGMENTED) {
+				for( size_t seg = 0, b = 0; seg < NUM_SEGMENTS; b += S << seg, ++seg ) {
+					if( !m_directory[seg].load() ) continue;
+					for( size_t i = std::max(b, num_blocks); i < b + (S << seg); ++i ) remove(i);
+				}
+			} else if( auto map_ptr = m_block_map.load() ) {
+				for( size_t b = num_blocks; b < map_ptr->m_blocks.size(); ++b ) remove(b);
 			}
+			for( auto num = m_num_reserved.load(); num > num_blocks && !m_num_reserved.compare_exchange_weak(num, num_blocks); );
 
-			map_ptr = new_map_ptr; ///<  remember for later	
-			m_block_map.store( map_ptr );
+			m_size_cnt.store( slot_size_t{ table_size(size), table_diff_t{0}, NUMBITS1 } ); //nothing else changes the counter while shrinking
+			notify_commit(0);
 		}
+		clear_block_cache();
 	}
 
 
-
 	/// \brief Pop the last row if there is one.
 	/// \param[out] idx_ptr Index of the deleted row.
-	/// \returnss values of the popped row.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::pop_back(table_index_t* idx_ptr) noexcept -> tuple_value_t {
+	/// \param[out] contended If not nullptr, give up instead of waiting if the size counter is contended, and set *contended to true.
+	/// \param[in] slot Epoch slot pinned by the calling view. Its pin does not keep a removed block alive, see VlltEpoch::retire().
+	/// \returns values of the popped row.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::pop_back(table_index_t* idx_ptr, bool* contended, size_t slot) noexcept -> tuple_value_t {
+		static_assert(!APPEND_ONLY, "Rows cannot be removed from APPEND_ONLY tables!");
 	vtll::to_tuple<vtll::remove_atomic<DATA>> ret{};
 		table_index_t idx{};
 		if(idx_ptr) *idx_ptr = idx; ///< Initialize the index to an invalid value
 
 		if constexpr (FAIR) {
-			if( m_starving.load()==1 ) m_starving.wait(1); //wait until pulls are done and pushes have a chance to catch up
-			if( table_diff(m_size_cnt.load()) > 4 ) m_starving.store(-1); //if pushes are starving the pulls, then prevent pushes
+			if( m_starving.load() == STARVING_PUSHES ) { //wait until pulls are done and pushes have a chance to catch up
+				if( contended ) { *contended = true; return {}; }
+				m_stats.add(stats_t::STARVING_WAITS);
+				VlltBackoff backoff;
+				for( auto starving = m_starving.load(); starving == STARVING_PUSHES; starving = m_starving.load() ) backoff.wait(m_starving, starving);
+			}
+			if( table_diff(m_size_cnt.load()) > 4 ) m_starving.store(STARVING_POPS); //if pushes are starving the pulls, then prevent pushes
+		}
+
+		slot_size_t size = m_size_cnt.load();
+		if (table_size(size) + table_diff(size) == 0) return {};	///< Is there a row to pop off?
+
+		/// Make sure that no other thread is currently pushing a new row or shrinking the table
+		VlltBackoff backoff;
+		while (table_diff(size) > 0 || table_diff(size) == SHRINKING || !m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size), table_diff(size) - 1, NUMBITS1 })) {
+			m_stats.add(stats_t::POP_CAS_RETRIES);
+			if( contended ) { *contended = true; return {}; }
+			if (table_diff(size) > 0 || table_diff(size) == SHRINKING) { //pushes or a shrink are running, they notify when they are committed
+				wait_size(backoff, size);
+				size = m_size_cnt.load(); 
+			}
+			if (table_size(size) + table_diff(size) == 0) return {};	///< Is there a row to pop off?
+		};
+
+		idx = table_size(size) + table_diff(size) - 1; 		///< Get the index of the row to pop
+		if(idx_ptr) *idx_ptr = idx; ///< Store index of popped row as out value
+
+		begin_rows();
+		auto block_ptr = get_block_ptr(idx);
+		move_row(block_ptr, idx, ret);
+		destroy_row(block_ptr, idx); ///< Call destructors
+
+		//shrink the table. Pops commit in any order, so the committed size can be smaller than the index of a pop that is still running.
+		//If this is the only running pop, no other thread accesses rows after idx, and pushes wait until this pop is committed.
+		auto bidx = block_idx(idx);
+		if( table_diff(m_size_cnt.load()) == -1 && bidx + 2 >= m_num_reserved.load(std::memory_order_relaxed) ) {
+			if( auto ptr = remove_block( (size_t)bidx + 2 ) ) m_epoch.retire(this, ptr, free_block, slot); //other threads might still access the block, free it later
+		}	
+
+		slot_size_t new_size = slot_size_t{ table_size(size), table_diff(size) - 1, NUMBITS1 };	///< Commit the popping of the row
+		while (!m_size_cnt.compare_exchange_weak(new_size, slot_size_t{ table_size(new_size) - 1, table_diff(new_size) + 1, NUMBITS1 })) {
+			m_stats.add(stats_t::POP_CAS_RETRIES);
+		}
+		end_rows();
+		notify_commit(table_diff(new_size) + 1);
+		
+		return ret; //RVO?
+	}
+
+
+	/// \brief Remove rows from the back of the table. All rows are claimed with a single CAS on the size counter. 
+	/// Since the diff of the counter has only a few bits, the rows are claimed like a single pop: the size is decreased 
+	/// by num-1 and the diff by 1, and the commit is the same as for pop_back(). Pushes wait until the rows are removed.
+	/// \param[in] count Function that gets the number of rows and returns the number of rows to remove.
+	/// \param[out] out Output iterator receiving the values of the removed rows, last row first. If nullptr, the rows are only destroyed.
+	/// \returns Number of removed rows.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	template<typename F, typename It>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::pop_back_range(F&& count, It out) noexcept -> size_t {
+		static_assert(!APPEND_ONLY, "Rows cannot be removed from APPEND_ONLY tables!");
+
+		if constexpr (FAIR) {
+			if( m_starving.load() == STARVING_PUSHES ) { //wait until pulls are done and pushes have a chance to catch up
+				m_stats.add(stats_t::STARVING_WAITS);
+				VlltBackoff backoff;
+				for( auto starving = m_starving.load(); starving == STARVING_PUSHES; starving = m_starving.load() ) backoff.wait(m_starving, starving);
+			}
+			if( table_diff(m_size_cnt.load()) > 4 ) m_starving.store(STARVING_POPS); //if pushes are starving the pulls, then prevent pushes
 		}
 
+		VlltBackoff backoff;
 		slot_size_t size = m_size_cnt.load();
-		if (table_size(size) + table_diff(size) == 0) return {};	///< Is there a row to pop off?
-
-		/// Make sure that no other thread is currently pushing a new row
-		while (table_diff(size) > 0 || !m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size), table_diff(size) - 1, NUMBITS1 })) {
-			if (table_diff(size) > 0) { size = m_size_cnt.load(); }
-			if (table_size(size) + table_diff(size) == 0) return {};	///< Is there a row to pop off?
-		};
-
-		auto map_ptr{ m_block_map.load() };						///< Access the block map
+		size_t num = 0;
+		while( true ) {
+			if (table_diff(size) > 0 || table_diff(size) == SHRINKING) { //pushes or a shrink are running, they notify when they are committed
+				m_stats.add(stats_t::POP_CAS_RETRIES);
+				wait_size(backoff, size);
+				size = m_size_cnt.load(); 
+				continue;
+			}
+			num = count( (size_t)table_size(size) + table_diff(size) );
+			if( num == 0 ) return 0;
+			if( m_size_cnt.compare_exchange_weak(size, slot_size_t{ table_size(size) - num + 1, table_diff(size) - 1, NUMBITS1 }) ) break;
+			m_stats.add(stats_t::POP_CAS_RETRIES);
+		}
 
-		idx = table_size(size) + table_diff(size) - 1; 		///< Get the index of the row to pop
-		if(idx_ptr) *idx_ptr = idx; ///< Store index of popped row as out value
+		auto last = table_index_t{ (size_t)table_size(size) + table_diff(size) };
+		auto first = table_index_t{ last - num };
+		begin_rows();
+		if constexpr (!std::is_same_v<It, std::nullptr_t>) {
+			auto blocks = get_blocks();
+			for( auto n = last; n > first; ) {
+				--n;
+				vtll::to_tuple<vtll::remove_atomic<DATA>> ret{};
+				move_row( blocks( (size_t)block_idx(n) ), n, ret );
+				*out = std::move(ret);
+				++out;
+			}
+		}
+		destroy_rows(first, last); ///< Call destructors
 
-		auto block_ptr = m_block_map.load()->m_blocks[(size_t)block_idx(idx)].load();
-		vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
-			[&](auto i) {
-				using type = vtll::Nth_type<DATA, i>;
-				if		constexpr (std::is_move_assignable_v<type>) { std::get<i>(ret) = std::move(* (this->template get_component_ptr<i>(block_ptr, table_index_t{ idx })) ); }	//move
-				else if constexpr (std::is_copy_assignable_v<type>) { std::get<i>(ret) = *(this->template get_component_ptr<i>(block_ptr, table_index_t{ idx }, map_ptr)); }		//copy
-				else if constexpr (vtll::is_atomic<type>::value) { std::get<i>(ret) = this->template get_component_ptr<i>(block_ptr, table_index_t{ idx }, map_ptr)->load(); } 		//atomic
+		slot_size_t new_size = slot_size_t{ table_size(size) - num + 1, table_diff(size) - 1, NUMBITS1 };	///< Commit like a single pop
+		while (!m_size_cnt.compare_exchange_weak(new_size, slot_size_t{ table_size(new_size) - 1, table_diff(new_size) + 1, NUMBITS1 })) {
+			m_stats.add(stats_t::POP_CAS_RETRIES);
+		}
+		end_rows();
+		notify_commit(table_diff(new_size) + 1);
+		return num;
+	}
 
-				if constexpr (std::is_destructible_v<type> && !std::is_trivially_destructible_v<type>) { this->template get_component_ptr<i>(block_ptr, table_index_t{ idx })->~type(); }	///< Call destructor
-			}
-		);
 
-		//shrink the table
-		auto bidx = block_idx(table_size(size));
-		if( bidx + 2 < map_ptr->m_blocks.size() ) {
-			map_ptr->m_blocks[(size_t)bidx + 2].store(nullptr);
-		}	
+	/// \brief Pop up to num rows from the back of the table with a single CAS, see pop_back_range().
+	/// \param[in] num Maximal number of rows to pop.
+	/// \param[out] out Output iterator receiving the values of the popped rows as tuples, like pop_back(), last row first. If nullptr, the rows are only destroyed.
+	/// \returns Number of popped rows.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	template<typename It>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::pop_back_n(size_t num, It out) noexcept -> size_t {
+		return pop_back_range( [&](size_t rows) { return std::min(num, rows); }, out );
+	}
 
-		slot_size_t new_size = slot_size_t{ table_size(size), table_diff(size) - 1, NUMBITS1 };	///< Commit the popping of the row
-		while (!m_size_cnt.compare_exchange_weak(new_size, slot_size_t{ table_size(new_size) - 1, table_diff(new_size) + 1, NUMBITS1 }));
 
-		if constexpr (FAIR) {
-			if(table_diff(new_size) + 1 == 0) { 
-				m_starving.store(0); //allow pushes again
-				m_starving.notify_all(); //notify all waiting threads
-			}
-		}	
-		
-		return ret; //RVO?
+	/// \brief Remove all rows from row n on with a single CAS, see pop_back_range(). If all components are trivially destructible, 
+	/// this takes constant time. Blocks are kept, so the table can be filled again without allocating.
+	/// \param[in] n New number of rows.
+	/// \returns Number of removed rows.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::truncate(size_t n) noexcept -> size_t {
+		return pop_back_range( [&](size_t rows) { return rows > n ? rows - n : 0; }, nullptr );
 	}
 
 
-	/// \brief Pop all rows and call the destructors.
-	/// \returnss number of popped rows.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::clear() noexcept {
-		auto num = size();
-		table_index_t idx;
-		pop_back(&idx);
-		while( idx.has_value()) { pop_back(&idx); }
-		return num;
+	/// \brief Remove all rows and call the destructors.
+	/// \returns number of removed rows.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::clear() noexcept {
+		return truncate(0);
 	}
 
 
-	/// \brief Swap the values of two rows.
-	/// \param[in] n1 Index of first row.
-	/// \param[in] n2 Index of second row.
-	/// \returnss true if the operation was successful.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::swap( auto src, auto dst ) noexcept -> void {
-		if constexpr (std::is_same_v< decltype(src), table_index_t  >) assert(dst < size() && src < size());
+	/// \brief Swap the values of two tuples. Both are swapped in place, so they must be lvalues or tuples of references.
+	/// \param[in] src Tuple holding values or references to the components of a row.
+	/// \param[in] dst Tuple holding values or references to the components of a row.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::swap( auto&& src, auto&& dst ) noexcept -> void {
 		vtll::static_for<size_t, 0, vtll::size<DATA>::value >([&](auto i) {
 			using type = vtll::Nth_type<DATA, i>;
 			if constexpr (std::is_move_assignable_v<type> && std::is_move_constructible_v<type>) {
 				std::swap(std::get<i>(dst), std::get<i>(src));
 			}
 			else if constexpr (std::is_copy_assignable_v<type> && std::is_copy_constructible_v<type>) {
-				auto& tmp{ std::get<i>(src) };
+				type tmp{ std::get<i>(src) };
 				std::get<i>(src) = std::get<i>(dst);
 				std::get<i>(dst) = tmp;
 			}
@@ -657,13 +2513,15 @@ namespace vllt {
 
 	/// \brief Remove a row from the table.
 	/// \param n1 Index of the row to remove.
+	/// \param slot Epoch slot pinned by the calling view, see pop_back().
 	/// \returns Tuple holding the values of the removed row.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR> requires VlltStaticTableConcept<DATA>
-	inline auto VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>::erase(table_index_t n1) -> tuple_value_t {
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN> requires VlltStaticTableConcept<LAYOUT>
+	inline auto VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>::erase(table_index_t n1, size_t slot) -> tuple_value_t {
 		table_index_t n2;
-		auto ret = pop_back( &n2 );
-		if (n1 == n2) return ret;
-		swap( ret, get_ref_tuple<DATA>(n1)); 
+		begin_rows(); //readers must not see the popped row in place of row n1
+		auto ret = pop_back( &n2, nullptr, slot );
+		if (n1 != n2) swap( ret, get_ref_tuple<DATA>(n1)); 
+		end_rows();
 		return ret;
 	}
 
@@ -721,60 +2579,65 @@ namespace vllt {
 
 
 	/// \brief VlltStaticTableView is a view to a VlltStaticTable. It allows to read and write to the table.
-	/// \tparam DATA Types of the table.
+	/// \tparam LAYOUT Types of the table, may contain column groups.
 	/// \tparam SYNC Synchronization type for the table.
 	/// \tparam N0 Number of rows in a block.
 	/// \tparam ROW If true, then the table is row based, otherwise column based.
 	/// \tparam MINSLOTS Minimum number of slots in a block.
 	/// \tparam FAIR If true, then the table is fair, otherwise not.
+	/// \tparam STORAGE Storage engine that manages the blocks of the table.
+	/// \tparam STATS If true, the table counts contention and allocations, see stats().
+	/// \tparam ALIGN Alignment of the columns of a block in bytes, 0 uses the natural alignment of each column.
 	/// \tparam READ Types that can be read from the table.
 	/// \tparam WRITELIST Types that can be written to the table.
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, typename READ, typename WRITELIST>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ, typename WRITELIST>
 	class VlltStaticTableView : public VlltStaticTableViewBase {
 	public:
-		using WRITE = std::conditional_t< vtll::is_same_set<WRITELIST, vtll::tl<VlltWrite> >::value, DATA, WRITELIST>; ///< Types that can be written to the table
+		using DATA = VlltColumns<LAYOUT>; ///< Types of the columns of the table
+		using WRITE = std::conditional_t< VlltOnlyPushback<WRITELIST>, DATA, WRITELIST>; ///< Types that can be written to the table
 		
-		using table_type = VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>; ///< Type of the table
+		using table_type = VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>; ///< Type of the table
 		using tuple_value_t = table_type::tuple_value_t;	///< Tuple holding the entries as value
 		using tuple_ref_t = vtll::to_ref_tuple<WRITE>; ///< Tuple holding refs to the entries
 		using tuple_const_ref_t = vtll::to_const_ref_tuple<READ>; ///< Tuple holding refs to the entries
 		using tuple_return_t = vtll::to_tuple< vtll::cat< vtll::to_const_ref<READ>, vtll::to_ref<WRITE> > >; ///< Tuple holding refs to the entries
-		using iterator_t = VtllStaticIterator<DATA, SYNC, N0, ROW, MINSLOTS, FAIR, READ, WRITELIST, WRITE>;
+		using iterator_t = VtllStaticIterator<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, READ, WRITELIST, WRITE>;
+		using tokens_t = std::array<size_t, table_type::NUM_LOCKS>; ///< Tokens of the shared column locks
 
-		friend class VlltStaticTable<DATA, SYNC, N0, ROW, MINSLOTS, FAIR>; ///< Allow the table to access the view
+		/// Access of the view to each column of the table: 0 none, 1 read, 2 write. Pushback-only views only add rows, so they do not access columns.
+		static constexpr std::array<int, vtll::size<DATA>::value> ACCESS = []<size_t... Is>(std::index_sequence<Is...>) {
+			return std::array<int, vtll::size<DATA>::value>{ (vtll::has_type<READ, vtll::Nth_type<DATA, Is>>::value ? 1 
+				: (!VlltOnlyPushback<WRITELIST> && vtll::has_type<WRITE, vtll::Nth_type<DATA, Is>>::value ? 2 : 0))... };
+		}(std::make_index_sequence<vtll::size<DATA>::value>{});
 
-		/// \brief Constructor of class VlltStaticTableView. This is private because only the table is allowed to create a view.
-		VlltStaticTableView(table_type& table ) : VlltStaticTableViewBase{}, m_table{ table } {	
-			if constexpr (SYNC == sync_t::VLLT_SYNC_EXTERNAL || SYNC == sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK) return;
-			if constexpr (VlltOnlyPushback<WRITELIST>) return;
+		/// Can the view add or remove rows? Pushback-only and owner views can, this changes all columns of the table.
+		static constexpr bool CHANGES_ROWS = VlltWriteAll<DATA, WRITE>;
 
-			vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
-				[&](auto i) {
-					if constexpr ( vtll::size<READ>::value >0 && vtll::has_type<READ,vtll::Nth_type<DATA,i>>::value ) { 
-						if constexpr (SYNC == sync_t::VLLT_SYNC_DEBUG || SYNC == sync_t::VLLT_SYNC_DEBUG_PUSHBACK) assert(m_table.m_access_mutex[i].try_lock_shared());
-						else m_table.m_access_mutex[i].lock_shared(); 
-					}
-					else if constexpr ( vtll::size<WRITE>::value >0 && vtll::has_type<WRITE,vtll::Nth_type<DATA,i>>::value) { 
-						if constexpr (SYNC == sync_t::VLLT_SYNC_DEBUG || SYNC == sync_t::VLLT_SYNC_DEBUG_PUSHBACK) assert(m_table.m_access_mutex[i].try_lock());
-						else m_table.m_access_mutex[i].lock(); 
-					}
-				}
-			);
+		friend class VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>; ///< Allow the table to access the view
+
+		template<typename VIEW>
+		friend class VlltViewAwaiter; ///< Allow awaiters to lock the columns of the view
+
+		template<typename... VIEWS>
+		friend class VlltViewGroup; ///< Allow view groups to lock the columns of the view
+
+		/// \brief Constructor of class VlltStaticTableView. This is private because only the table is allowed to create a view.
+		VlltStaticTableView(table_type& table ) : VlltStaticTableViewBase{}, m_table{ table }, m_guard{ table.m_epoch } {	
+			lock(m_table, m_lock_tokens);
 		};	
 		
+		/// \brief Constructor of class VlltStaticTableView for columns that have already been locked by try_lock().
+		VlltStaticTableView(table_type& table, std::adopt_lock_t, const tokens_t& tokens ) 
+			: VlltStaticTableViewBase{}, m_table{ table }, m_guard{ table.m_epoch }, m_lock_tokens{ tokens } {};
 
 	public:
 		/// \brief Destructor of class VlltStaticTableView
 		~VlltStaticTableView() {
-			if constexpr (SYNC == sync_t::VLLT_SYNC_EXTERNAL || SYNC == sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK) return;
-			if constexpr (VlltOnlyPushback<WRITELIST>) return;
-
-			vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
-				[&](auto i) {
-					if constexpr ( vtll::has_type<READ,vtll::Nth_type<DATA,i>>::value ) { m_table.m_access_mutex[i].unlock_shared(); }
-					else if constexpr ( vtll::has_type<WRITE,vtll::Nth_type<DATA,i>>::value) { m_table.m_access_mutex[i].unlock(); }
-				}
-			);
+			if constexpr (VlltChunkedPushback<WRITELIST>) flush();
+			if constexpr (!HAS_LOCKS) return;
+			end_view_write();
+			unlock(m_table, m_lock_tokens);
+			m_table.m_waiters.wake(); //resume coroutines waiting for these columns
 		};
 
 		VlltStaticTableView(VlltStaticTableView& other) = delete; ///< Copy constructor is deleted
@@ -784,37 +2647,165 @@ namespace vllt {
 	
 		inline auto size() noexcept (!VlltOnlyPushback<WRITELIST>) { return m_table.size(); } ///< Return the number of rows in the table.
 
+		/// \brief Number of objects that can be accessed through a span handed out by for_each_block(), see VlltStaticTable::padded_size().
+		template<typename T, size_t E>
+		inline auto padded_size(std::span<T, E> span) const noexcept -> size_t requires (!ROW) { return m_table.padded_size(span); }
+
 		/// \brief Add a new row to the table.
 		/// \tparam ...Cs Types of the data to add.
 		/// \param ...data Data to add.
-		/// \returnss Index of the new row.
+		/// \returns Index of the new row. Chunked views only buffer the row and return an invalid index, see flush().
 		template<typename... Cs>
 			requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<DATA>>
 		inline auto push_back(Cs&&... data) -> table_index_t requires VlltWriteAll<DATA, WRITE> { 
-			return m_table.push_back_p(std::forward<Cs>(data)...); 
+			if constexpr (VlltChunkedPushback<WRITELIST>) {
+				m_chunk.emplace_back(std::forward<Cs>(data)...);
+				if( m_chunk.size() == CHUNK_SIZE ) flush();
+				return table_index_t{};
+			}
+			else return m_table.push_back_p(std::forward<Cs>(data)...); 
+		};
+
+		/// \brief Add a new row to the table, constructing each component in place from the respective argument.
+		/// \tparam ...Args Types of the arguments, one per column in the order of the table types.
+		/// \param ...args Arguments for constructing the components.
+		/// \returns Index of the new row. Chunked views only buffer the row and return an invalid index, see flush().
+		template<typename... Args>
+			requires VlltConstructible<DATA, Args...>
+		inline auto emplace_back(Args&&... args) -> table_index_t requires VlltWriteAll<DATA, WRITE> { 
+			if constexpr (VlltChunkedPushback<WRITELIST>) {
+				m_chunk.emplace_back(std::forward<Args>(args)...);
+				if( m_chunk.size() == CHUNK_SIZE ) flush();
+				return table_index_t{};
+			}
+			else return m_table.emplace_back_p(std::forward<Args>(args)...); 
+		};
+
+		/// \brief Chunked pushback-only views: add the rows pushed so far to the table. Their slots are reserved with one atomic 
+		/// operation and committed with another one. Called when the chunk is full, and by the destructor.
+		/// \returns Index of the first added row, or an invalid index if there were no rows.
+		inline auto flush() noexcept -> table_index_t requires VlltChunkedPushback<WRITELIST> {
+			if( m_chunk.empty() ) return table_index_t{};
+			auto row = m_chunk.begin();
+			auto first = m_table.push_back_n_p( m_chunk.size(), [&](auto block_ptr, table_index_t n) {
+				std::apply( [&](auto&... data) { m_table.construct_row(block_ptr, n, std::move(data)...); }, *row );
+				++row;
+			});
+			m_chunk.clear();
+			return first;
+		}
+
+		/// \brief Add num copies of a row to the table. Slots are reserved and committed with one atomic operation
+		/// per table_type::PUSH_N_MAX rows, so rows are only guaranteed to be consecutive for up to this number.
+		/// \param num Number of rows to add.
+		/// \param ...data Data of each new row.
+		/// \returns Index of the first new row.
+		template<typename... Cs>
+			requires std::is_same_v<vtll::tl<std::decay_t<Cs>...>, vtll::remove_atomic<DATA>>
+		inline auto push_back_n(size_t num, Cs&&... data) -> table_index_t requires VlltWriteAll<DATA, WRITE> { 
+			if constexpr (VlltChunkedPushback<WRITELIST>) flush(); //keep the order of the rows
+			table_index_t first{};
+			for( size_t i = 0; i < num; i += table_type::PUSH_N_MAX ) {
+				auto n = m_table.push_back_n_p( std::min(num - i, table_type::PUSH_N_MAX), [&](auto block_ptr, table_index_t n) { m_table.construct_row(block_ptr, n, data...); } );
+				if( i == 0 ) first = n;
+			}
+			return first;
+		};
+
+		/// \brief Add all rows of a range to the table. Slots are reserved and committed with one atomic operation
+		/// per table_type::PUSH_N_MAX rows, so rows are only guaranteed to be consecutive for up to this number.
+		/// \param range Sized range of tuples, holding the values of a row in the order of the table types.
+		/// \returns Index of the first new row.
+		template<std::ranges::sized_range R>
+		inline auto push_back_range(R&& range) -> table_index_t requires VlltWriteAll<DATA, WRITE> { 
+			if constexpr (VlltChunkedPushback<WRITELIST>) flush(); //keep the order of the rows
+			table_index_t first{};
+			size_t num = std::ranges::size(range);
+			auto it = std::ranges::begin(range);
+			for( size_t i = 0; i < num; i += table_type::PUSH_N_MAX ) {
+				auto n = m_table.push_back_n_p( std::min(num - i, table_type::PUSH_N_MAX), [&](auto block_ptr, table_index_t n) { 
+					std::apply( [&](auto&&... data) { m_table.construct_row(block_ptr, n, std::forward<decltype(data)>(data)...); }, *it );
+					++it;
+				});
+				if( i == 0 ) first = n;
+			}
+			return first;
 		};
 
 		/// \brief Get a tuple with refs to all components of an entry.
 		/// \param n Index to the entry.
-		/// \returnss a tuple with refs to all components of entry n.
+		/// \returns a tuple with refs to all components of entry n.
 		inline decltype(auto) get_ref_tuple(table_index_t n) requires (!VlltOnlyPushback<WRITELIST>) {
-			if constexpr (vtll::size<READ>::value == 0) return m_table.template get_ref_tuple<WRITE>(n);
-			else if constexpr (vtll::size<WRITE>::value == 0) return m_table.template get_const_ref_tuple<READ>(n);
-			else return std::tuple_cat( m_table.template get_const_ref_tuple<READ>(n), m_table.template get_ref_tuple<WRITE>(n) ); 
+			begin_view_write();
+			return get_ref_tuple(m_table.get_block_ptr(n), n);
 		};
 
 		/// \brief Pop last row from the table.
-		/// \returnss Tuple with the data of the last row.
-		inline auto pop_back(table_index_t *idx = nullptr ) noexcept requires VlltOwner<DATA, WRITE, WRITELIST> { return m_table.pop_back(idx); }; 
+		/// \returns Tuple with the data of the last row.
+		inline auto pop_back(table_index_t *idx = nullptr ) noexcept requires VlltRemover<DATA, SYNC, WRITE, WRITELIST> { return m_table.pop_back(idx, nullptr, m_guard.slot()); }; 
 
 		/// \brief Clear the table.
-		inline auto clear() noexcept requires VlltOwner<DATA, WRITE, WRITELIST> { return m_table.clear(); };
+		inline auto clear() noexcept requires VlltRemover<DATA, SYNC, WRITE, WRITELIST> { return m_table.clear(); };
+
+		/// Remove all rows from row n on, see VlltStaticTable::truncate().
+		inline auto truncate(size_t n) noexcept requires VlltRemover<DATA, SYNC, WRITE, WRITELIST> { return m_table.truncate(n); };
+
+		/// Remove up to num rows from the back, and move their values to the output iterator out, last row first.
+		template<typename It = std::nullptr_t>
+		inline auto pop_back_n(size_t num, It out = nullptr) noexcept requires VlltRemover<DATA, SYNC, WRITE, WRITELIST> { return m_table.pop_back_n(num, out); };
 
 		/// \brief Swap the values of two rows.
 		inline auto swap(table_index_t lhs, table_index_t rhs) noexcept -> void requires VlltOwner<DATA, WRITE, WRITELIST> { m_table.swap(lhs, rhs); };	
 		
 		/// \brief Erase a row from the table. Replace it with the last row. Return the values.
-		inline auto erase(table_index_t n) -> tuple_value_t requires VlltOwner<DATA, WRITE, WRITELIST> { return m_table.erase(n); }
+		inline auto erase(table_index_t n) -> tuple_value_t requires VlltRemover<DATA, SYNC, WRITE, WRITELIST> { return m_table.erase(n, m_guard.slot()); }
+
+		/// \brief Call a function for each block of the table. The function gets the index of the first row of the block,
+		/// and one span per accessed column, holding the rows of the block. Spans of read columns are const. 
+		/// Since rows of a block are contiguous only in column layout, this is not available for row based tables.
+		/// Columns of a virtual table are contiguous, so the function is called only once with spans over all rows.
+		/// Each span starts at the alignment of its column, see the ALIGN parameter of the table, and can be accessed up to padded_size().
+		/// \param[in] fun Function that is called as fun(table_index_t first, std::span<const READ>..., std::span<WRITE>...).
+		template<typename F>
+		inline auto for_each_block(F&& fun) -> void requires (!ROW && !VlltOnlyPushback<WRITELIST>) {
+			size_t size = m_table.size();
+			if( size == 0 ) return;
+			begin_view_write();
+			auto get_block = m_table.get_blocks(); //covers all rows that were there when size was read
+			size_t step = STORAGE == storage_t::VLLT_STORAGE_VIRTUAL ? size : table_type::N;
+			for( size_t first = 0; first < size; first += step ) {
+				auto block_ptr = get_block(first >> table_type::L);
+				auto num = std::min(step, size - first);
+				std::apply( fun, std::tuple_cat( std::make_tuple(table_index_t{first})
+					, m_table.template get_const_span_tuple<READ>(block_ptr, table_index_t{first}, num)
+					, m_table.template get_span_tuple<WRITE>(block_ptr, table_index_t{first}, num) ) );
+			}
+		}
+
+		/// \brief Call a function for each row of the table in parallel. The rows are split into chunks of whole blocks, 
+		/// so that no two threads write to the same block. The chunks are run by a thread pool, the calling thread helps.
+		/// The function gets the same tuple as returned by get_ref_tuple(), so only write columns can be changed.
+		/// \param[in] fun Function that is called as fun(tuple_return_t) for each row, must not throw.
+		/// \param[in] pool Thread pool running the chunks.
+		template<typename F>
+		inline auto parallel_for_each(F&& fun, VlltThreadPool& pool) -> void requires (!VlltOnlyPushback<WRITELIST>) {
+			size_t size = m_table.size();
+			if( size == 0 ) return;
+			begin_view_write(); //before the pool threads get references
+			auto get_block = m_table.get_blocks(); //covers all rows that were there when size was read
+			size_t num_blocks = (size + table_type::N - 1) >> table_type::L;
+			size_t blocks_per_chunk = std::max( num_blocks / (4 * (pool.size() + 1)), (size_t)1 ); //some chunks per thread for load balancing
+			size_t num_chunks = (num_blocks + blocks_per_chunk - 1) / blocks_per_chunk;
+
+			pool.parallel_for( num_chunks, [&](size_t chunk) {
+				size_t last_block = std::min( (chunk + 1) * blocks_per_chunk, num_blocks );
+				for( size_t b = chunk * blocks_per_chunk; b < last_block; ++b ) {
+					auto block_ptr = get_block(b);
+					size_t last = std::min( (b + 1) << table_type::L, size );
+					for( size_t n = b << table_type::L; n < last; ++n ) fun( get_ref_tuple(block_ptr, table_index_t{n}) );
+				}
+			});
+		}
 
 		/// \brief Equality comparison operator
     	friend bool operator==(const VlltStaticTableView& lhs, const VlltStaticTableView& rhs) {
@@ -853,6 +2844,7 @@ namespace vllt {
 			}
 
 			if constexpr (vtll::size<WRITE>::value > 0) {
+				begin_view_write();
 				auto ret = m_table.template get_ref_tuple<WRITE>(n);
 				vtll::static_for<size_t, 0, vtll::size<WRITE>::value >( [&](auto i) { ptr[j++] = &std::get<i>(ret) ; } );
 			}
@@ -862,6 +2854,16 @@ namespace vllt {
 
 	private:
 
+		/// \brief Get a tuple with refs to all components of an entry.
+		/// \param block_ptr Pointer to the block holding the entry.
+		/// \param n Index to the entry.
+		/// \returns a tuple with refs to all components of entry n.
+		inline decltype(auto) get_ref_tuple(auto block_ptr, table_index_t n) {
+			if constexpr (vtll::size<READ>::value == 0) return m_table.template get_ref_tuple<WRITE>(block_ptr, n);
+			else if constexpr (vtll::size<WRITE>::value == 0) return m_table.template get_const_ref_tuple<READ>(block_ptr, n);
+			else return std::tuple_cat( m_table.template get_const_ref_tuple<READ>(block_ptr, n), m_table.template get_ref_tuple<WRITE>(block_ptr, n) ); 
+		};
+
 		/// \brief Create an iterator to the beginning of the table.
 		/// \returns  Iterator to the beginning of the table.
 		virtual inline auto begin_p() -> VtllStaticIteratorBaseWrapper override { return VtllStaticIteratorBaseWrapper( begin(), sizeof(iterator_t) ); }; 
@@ -870,7 +2872,428 @@ namespace vllt {
 		/// \returns  Iterator to the end of the table.
 		virtual inline auto end_p() -> VtllStaticIteratorBaseWrapper override { return VtllStaticIteratorBaseWrapper( end(), sizeof(iterator_t) ); }; 
 
+		static constexpr bool HAS_LOCKS = table_type::NUM_LOCKS > 0 && !VlltOnlyPushback<WRITELIST>; ///< Does the view lock columns?
+
+		/// \brief Lock all columns of the view in the order of the table types. Blocks until all locks are acquired.
+		/// In DEBUG modes, an assertion fails if a lock is not free.
+		/// \param[in] table The table.
+		/// \param[out] tokens Tokens of the shared locks.
+		static inline auto lock(table_type& table, tokens_t& tokens) noexcept -> void {
+			if constexpr (!HAS_LOCKS) return;
+
+			vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
+				[&](auto i) {
+					[[maybe_unused]] auto t0 = STATS ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+					if constexpr ( vtll::size<READ>::value >0 && vtll::has_type<READ,vtll::Nth_type<DATA,i>>::value ) { 
+						if constexpr (SYNC == sync_t::VLLT_SYNC_DEBUG || SYNC == sync_t::VLLT_SYNC_DEBUG_PUSHBACK || SYNC == sync_t::VLLT_SYNC_DEBUG_APPEND_ONLY) { [[maybe_unused]] bool locked = table.m_access_mutex[i].try_lock_shared(tokens[i]); assert(locked); }
+						else tokens[i] = table.m_access_mutex[i].lock_shared(); 
+					}
+					else if constexpr ( vtll::size<WRITE>::value >0 && vtll::has_type<WRITE,vtll::Nth_type<DATA,i>>::value) { 
+						if constexpr (SYNC == sync_t::VLLT_SYNC_DEBUG || SYNC == sync_t::VLLT_SYNC_DEBUG_PUSHBACK || SYNC == sync_t::VLLT_SYNC_DEBUG_APPEND_ONLY) { [[maybe_unused]] bool locked = table.m_access_mutex[i].try_lock(); assert(locked); }
+						else table.m_access_mutex[i].lock(); 
+					}
+					if constexpr (STATS && i < VLLT_MAX_NUMBER_OF_COLUMNS) {
+						auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+						table.m_stats.add(table_type::stats_t::LOCK_WAIT_NS + i, (uint64_t)ns);
+					}
+				}
+			);
+		}
+
+		/// \brief Try to lock all columns of the view without waiting. If a lock is not free, the locks acquired so far are released.
+		/// \param[in] table The table.
+		/// \param[out] tokens Tokens of the shared locks.
+		/// \returns true if all columns have been locked.
+		static inline auto try_lock(table_type& table, tokens_t& tokens) noexcept -> bool {
+			if constexpr (!HAS_LOCKS) return true;
+
+			size_t locked = 0; ///< Number of columns that have been locked
+			auto try_lock_column = [&]<size_t I>() -> bool {
+				if constexpr ( vtll::has_type<READ,vtll::Nth_type<DATA,I>>::value ) { 
+					if( !table.m_access_mutex[I].try_lock_shared(tokens[I]) ) return false; 
+				}
+				else if constexpr ( vtll::has_type<WRITE,vtll::Nth_type<DATA,I>>::value) { 
+					if( !table.m_access_mutex[I].try_lock() ) return false; 
+				}
+				++locked;
+				return true;
+			};
+
+			if( [&]<size_t... Is>(std::index_sequence<Is...>) { return (try_lock_column.template operator()<Is>() && ...); }
+					(std::make_index_sequence<vtll::size<DATA>::value>{}) ) return true;
+
+			unlock(table, tokens, locked); //roll back
+			return false;
+		}
+
+		/// \brief Unlock the columns of the view.
+		/// \param[in] table The table.
+		/// \param[in] tokens Tokens of the shared locks.
+		/// \param[in] num Only the first num columns of the table are unlocked.
+		static inline auto unlock(table_type& table, const tokens_t& tokens, size_t num = vtll::size<DATA>::value) noexcept -> void {
+			if constexpr (!HAS_LOCKS) return;
+
+			vtll::static_for<size_t, 0, vtll::size<DATA>::value >(	///< Loop over all components
+				[&](auto i) {
+					if( i >= num ) return;
+					if constexpr ( vtll::has_type<READ,vtll::Nth_type<DATA,i>>::value ) { table.m_access_mutex[i].unlock_shared(tokens[i]); }
+					else if constexpr ( vtll::has_type<WRITE,vtll::Nth_type<DATA,i>>::value) { table.m_access_mutex[i].unlock(); }
+				}
+			);
+		}
+
+		/// Chunked pushback-only views: rows of a chunk, which are added to the table when the chunk is full
+		using chunk_t = std::vector< vtll::to_tuple<vtll::remove_atomic<DATA>> >;
+		static constexpr size_t CHUNK_SIZE = std::min(table_type::N, table_type::PUSH_N_MAX); ///< Number of rows in a full chunk
+
+		/// \brief Called before the view hands out references to its write columns. From then on until the view is destroyed, 
+		/// the write columns count this view as active writer, so optimistic views do not read them.
+		inline auto begin_view_write() noexcept -> void {
+			if constexpr (HAS_LOCKS && vtll::size<WRITE>::value > 0) {
+				if( m_writing ) return;
+				m_writing = true;
+				for( size_t i = 0; i < ACCESS.size(); ++i ) if( ACCESS[i] == 2 ) m_table.begin_write(m_table.m_column_version[i], table_type::VERSION_VIEW);
+			}
+		}
+
+		/// \brief Called before the view unlocks its columns.
+		inline auto end_view_write() noexcept -> void {
+			if constexpr (HAS_LOCKS && vtll::size<WRITE>::value > 0) {
+				if( !m_writing ) return;
+				for( size_t i = 0; i < ACCESS.size(); ++i ) if( ACCESS[i] == 2 ) m_table.end_write(m_table.m_column_version[i], table_type::VERSION_VIEW);
+			}
+		}
+
+		table_type& m_table; ///< Reference to the table
+		VlltEpochGuard m_guard; ///< Keeps blocks alive as long as the view exists
+		tokens_t m_lock_tokens{}; ///< Tokens of the shared column locks
+		bool m_writing{false}; ///< True if the view handed out references to its write columns
+		[[no_unique_address]] std::conditional_t<VlltChunkedPushback<WRITELIST>, chunk_t, std::monostate> m_chunk; ///< Rows of a chunked pushback-only view that are not in the table yet
+	};
+
+
+	/// \brief Awaiter returned by VlltStaticTable::async_view(). If the columns of the view are not free, the coroutine is 
+	/// parked in the wait list of the table, and resumed by the thread that destroys the last conflicting view.
+	/// \tparam VIEW Type of the view.
+	template<typename VIEW>
+	class VlltViewAwaiter : public VlltWaitList::waiter_t {
+	public:
+		using table_type = typename VIEW::table_type; ///< Type of the table
+
+		VlltViewAwaiter(table_type& table) noexcept : m_table{ table } {}
+
+		inline auto await_ready() noexcept -> bool { 
+			if( VIEW::try_lock(m_table, m_tokens) ) return true;
+			m_table.m_waiters.wake(); //a failed try might have held a lock while parked coroutines were tested
+			return false;
+		}
+		inline auto await_suspend(std::coroutine_handle<> handle) noexcept -> bool { m_handle = handle; return m_table.m_waiters.park(*this); }
+		inline auto await_resume() noexcept -> VIEW { return VIEW(m_table, std::adopt_lock, m_tokens); }
+
+	private:
+		inline auto try_acquire() noexcept -> bool override { return VIEW::try_lock(m_table, m_tokens); }
+
+		table_type& m_table; ///< Reference to the table
+		typename VIEW::tokens_t m_tokens{}; ///< Tokens of the shared column locks
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+	//view groups
+
+	#ifndef VLLT_MAX_ACQUIRE_TRIES
+		#define VLLT_MAX_ACQUIRE_TRIES 16	///< acquire() tries this often without blocking, then it waits for the locks in order
+	#endif
+
+	/// \brief Specification of a view, returned by VlltStaticTable::spec(). Used for acquiring several views with acquire().
+	/// \tparam VIEW Type of the view.
+	template<typename VIEW>
+	struct VlltViewSpec {
+		typename VIEW::table_type& m_table; ///< The table
+	};
+
+
+	/// \brief A group of views on different tables, returned by acquire(). All columns of all views are locked together, 
+	/// and unlocked when the group is destroyed. Access the views with get<I>() or structured bindings.
+	/// \tparam ...VIEWS Types of the views.
+	template<typename... VIEWS>
+	class VlltViewGroup {
+	public:
+		static constexpr size_t N = sizeof...(VIEWS); ///< Number of views
+
+		/// \brief Lock all columns of all views. Locks are ordered by table address and column index, so two groups can 
+		/// never deadlock. First all locks are tried without waiting. If one fails, all locks are released, and the group 
+		/// backs off before trying again. After VLLT_MAX_ACQUIRE_TRIES tries, the locks are acquired in order, blocking.
+		/// \param[in] ...specs Specifications of the views, the tables must be different.
+		VlltViewGroup(VlltViewSpec<VIEWS>... specs) {
+			std::tuple<typename VIEWS::table_type&...> tables{ specs.m_table... };
+			std::tuple<typename VIEWS::tokens_t...> tokens{};
+			std::array<const void*, N> addresses{ static_cast<const void*>(&specs.m_table)... };
+			std::array<size_t, N> order;
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return std::less<const void*>{}(addresses[a], addresses[b]); });
+			assert( std::adjacent_find(order.begin(), order.end(), [&](size_t a, size_t b) { return addresses[a] == addresses[b]; }) == order.end() );
+
+			auto visit = [&](size_t i, auto&& fun) { //call fun with the view type, table and tokens of view i
+				[&]<size_t... Is>(std::index_sequence<Is...>) { 
+					((i == Is ? fun(std::type_identity<VIEWS>{}, std::get<Is>(tables), std::get<Is>(tokens)) : void()), ...);
+				}(std::make_index_sequence<N>{});
+			};
+
+			for( size_t attempt = 0; ; ++attempt ) {
+				if( attempt == VLLT_MAX_ACQUIRE_TRIES ) {
+					for( auto i : order ) visit(i, [](auto v, auto& table, auto& tk) { decltype(v)::type::lock(table, tk); });
+					break;
+				}
+
+				size_t locked = 0;
+				bool success = true;
+				for( ; locked < N && success; ++locked ) {
+					visit(order[locked], [&](auto v, auto& table, auto& tk) { success = decltype(v)::type::try_lock(table, tk); });
+				}
+				if( success ) break;
+
+				for( size_t k = locked - 1; k-- > 0; ) { //release in reverse order
+					visit(order[k], [](auto v, auto& table, auto& tk) { decltype(v)::type::unlock(table, tk); });
+				}
+				for( size_t k = 0; k < locked; ++k ) { //resume coroutines that might have missed the locks held meanwhile
+					visit(order[k], [](auto, auto& table, auto&) { table.m_waiters.wake(); });
+				}
+
+				for( size_t k = 0; k < (size_t{1} << std::min(attempt, size_t{6})); ++k ) std::this_thread::yield(); //exponential back off
+			}
+
+			[&]<size_t... Is>(std::index_sequence<Is...>) { 
+				(std::get<Is>(m_views).emplace(std::get<Is>(tables), std::adopt_lock, std::get<Is>(tokens)), ...);
+			}(std::make_index_sequence<N>{});
+		}
+
+		VlltViewGroup(const VlltViewGroup&) = delete;
+		VlltViewGroup& operator=(const VlltViewGroup&) = delete;
+
+		template<size_t I>
+		inline auto get() noexcept -> vtll::Nth_type<vtll::tl<VIEWS...>, I>& { return *std::get<I>(m_views); } ///< \returns view I
+
+	private:
+		std::tuple<std::optional<VIEWS>...> m_views; ///< The views, constructed in place after all columns have been locked
+	};
+
+
+	/// \brief Acquire views on several tables at once, without risking deadlocks.
+	/// \param[in] ...specs Specifications of the views, e.g. table.spec<int, VlltWrite, float>(). The tables must be different.
+	/// \returns a group of views, use structured bindings to access them.
+	template<typename... VIEWS>
+	inline auto acquire(VlltViewSpec<VIEWS>... specs) -> VlltViewGroup<VIEWS...> {
+		return VlltViewGroup<VIEWS...>{ specs... };
+	}
+
+
+	//---------------------------------------------------------------------------------------------------
+	//scheduler
+
+	/// \brief Runs systems in parallel on a thread pool. A system is a function that is declared together with the views it needs.
+	/// Two systems conflict if they access the same column of the same table, and at least one of them writes to it. 
+	/// Views that can push, pop or erase rows count as writing to all columns of their table.
+	/// When a system is added, it is made to depend on all earlier systems it conflicts with, so the systems form a DAG.
+	/// run() starts each system as soon as all systems it depends on have finished. Conflicting systems never run at 
+	/// the same time, so tables can use VLLT_SYNC_EXTERNAL and no locks are taken.
+	class VlltScheduler {
+	public:
+		/// \brief Constructor of class VlltScheduler
+		/// \param[in] pool The thread pool running the systems.
+		VlltScheduler(VlltThreadPool& pool) noexcept : m_pool{ pool } {}
+
+		/// \brief Add a system. 
+		/// \param[in] fun The system, it is called with one view per specification, must not throw.
+		/// \param[in] ...specs Specifications of the views, e.g. table.spec<int, VlltWrite, float>(). The tables must be different.
+		/// \returns the index of the system.
+		template<typename F, typename... VIEWS>
+		inline auto add(F&& fun, VlltViewSpec<VIEWS>... specs) -> size_t {
+			system_t system;
+			system.m_run = [fun = std::forward<F>(fun), specs...]() mutable {
+				VlltViewGroup<VIEWS...> views{ specs... }; //takes no locks for external tables
+				[&]<size_t... Is>(std::index_sequence<Is...>) { fun(views.template get<Is>()...); }(std::make_index_sequence<sizeof...(VIEWS)>{});
+			};
+			( add_access<VIEWS>(system, &specs.m_table), ... );
+
+			size_t idx = m_systems.size();
+			for( size_t i = 0; i < idx; ++i ) {
+				if( !conflict(m_systems[i], system) ) continue;
+				m_systems[i].m_successors.push_back(idx);
+				++system.m_num_predecessors;
+			}
+			m_systems.push_back(std::move(system));
+			return idx;
+		}
+
+		/// \brief Return whether two systems conflict, i.e., must not run at the same time.
+		inline auto conflict(size_t a, size_t b) const noexcept -> bool { return conflict(m_systems[a], m_systems[b]); }
+
+		inline auto size() const noexcept -> size_t { return m_systems.size(); } ///< Return the number of systems.
+
+		/// \brief Run all systems once and wait until they have finished. The calling thread helps running systems.
+		inline auto run() -> void {
+			if( m_systems.empty() ) return;
+			std::vector<std::atomic<size_t>> pending(m_systems.size()); ///< Number of unfinished systems each system depends on
+			for( size_t i = 0; i < m_systems.size(); ++i ) pending[i].store(m_systems[i].m_num_predecessors);
+			auto remaining = std::make_shared<std::atomic<size_t>>(m_systems.size()); //jobs might notify after this function returned
+
+			for( size_t i = 0; i < m_systems.size(); ++i ) {
+				if( m_systems[i].m_num_predecessors == 0 ) start(i, pending, remaining);
+			}
+			m_pool.wait(*remaining);
+		}
+
+	private:
+		struct access_t {
+			const void* m_table; ///< Address of the table
+			size_t		m_column; ///< Index of the column
+			bool		m_write; ///< If true, the system writes to the column
+		};
+
+		struct system_t {
+			std::function<void()>	m_run; ///< Creates the views and calls the system
+			std::vector<access_t>	m_access; ///< Columns accessed by the system
+			std::vector<size_t>		m_successors; ///< Systems that depend on this system
+			size_t					m_num_predecessors{0}; ///< Number of systems this system depends on
+		};
+
+		template<typename VIEW>
+		static inline auto add_access(system_t& system, const void* table) -> void {
+			for( size_t i = 0; i < VIEW::ACCESS.size(); ++i ) {
+				if( VIEW::CHANGES_ROWS || VIEW::ACCESS[i] != 0 ) system.m_access.push_back( { table, i, VIEW::CHANGES_ROWS || VIEW::ACCESS[i] == 2 } );
+			}
+		}
+
+		static inline auto conflict(const system_t& a, const system_t& b) noexcept -> bool {
+			for( auto& x : a.m_access ) {
+				for( auto& y : b.m_access ) {
+					if( x.m_table == y.m_table && x.m_column == y.m_column && (x.m_write || y.m_write) ) return true;
+				}
+			}
+			return false;
+		}
+
+		/// \brief Submit a system to the pool. When it has finished, start all systems that only waited for it.
+		inline auto start(size_t idx, std::vector<std::atomic<size_t>>& pending, std::shared_ptr<std::atomic<size_t>> remaining) -> void {
+			m_pool.submit( [this, idx, &pending, remaining]() {
+				m_systems[idx].m_run();
+				for( auto succ : m_systems[idx].m_successors ) {
+					if( pending[succ].fetch_sub(1) == 1 ) start(succ, pending, remaining);
+				}
+				if( remaining->fetch_sub(1) == 1 ) remaining->notify_all();
+			}, idx );
+		}
+
+		VlltThreadPool& m_pool; ///< Runs the systems
+		std::vector<system_t> m_systems; ///< All systems in the order they were added
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+	//optimistic view
+
+	/// \brief VlltOptimisticView reads columns of an internally synced table without locking them, like a seqlock.
+	/// Each column has a version that counts its active writers: write views that handed out references to the column, 
+	/// and running pushes, pops, erases and swaps, which also change the version of the rows. A read copies the components 
+	/// of a row and is valid only if no writer was active and the versions did not change while copying. So writers never 
+	/// wait for optimistic readers, and readers retry if they read while a writer was active.
+	/// \tparam LAYOUT Types of the table, may contain column groups.
+	/// \tparam SYNC Synchronization type for the table.
+	/// \tparam N0 Number of rows in a block.
+	/// \tparam ROW If true, then the table is row based, otherwise column based.
+	/// \tparam MINSLOTS Minimum number of slots in a block.
+	/// \tparam FAIR If true, then the table is fair, otherwise not.
+	/// \tparam STORAGE Storage engine that manages the blocks of the table.
+	/// \tparam STATS If true, the table counts contention and allocations, see stats().
+	/// \tparam ALIGN Alignment of the columns of a block in bytes, 0 uses the natural alignment of each column.
+	/// \tparam READ Types that can be read from the table, must be trivially copyable.
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ>
+	class VlltOptimisticView {
+	public:
+		using DATA = VlltColumns<LAYOUT>; ///< Types of the columns of the table
+		using table_type = VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>; ///< Type of the table
+		using tuple_value_t = vtll::to_tuple<READ>;	///< Tuple holding copies of the components
+
+		friend class VlltStaticTable<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN>; ///< Allow the table to access the view
+
+		VlltOptimisticView(table_type& table ) : m_table{ table }, m_guard{ table.m_epoch } {}
+
+		VlltOptimisticView(VlltOptimisticView& other) = delete; ///< Copy constructor is deleted
+		VlltOptimisticView& operator=(VlltOptimisticView& other) = delete; ///< Copy assignment operator is deleted
+		VlltOptimisticView(VlltOptimisticView&& other) = delete; ///< Move constructor is deleted
+		VlltOptimisticView& operator=(VlltOptimisticView&& other) = delete; ///< Move assignment operator is deleted
+
+		inline auto size() noexcept { return m_table.size(); } ///< Return the number of rows in the table.
+
+		/// \brief Try once to read a row.
+		/// \param[in] n Index of the row.
+		/// \returns a tuple with copies of the components, or std::nullopt if a writer was active or the row does not exist.
+		inline auto try_get(table_index_t n) noexcept -> std::optional<tuple_value_t> {
+			auto versions = load_versions();
+			if( !versions ) return std::nullopt;
+
+			if( n >= m_table.size() ) return std::nullopt;
+			auto block_ptr = m_table.find_block( (size_t)table_type::block_idx(n) );
+			if( !block_ptr ) return std::nullopt; //the row was removed meanwhile
+
+			auto ret = [&] <size_t... Is>(std::index_sequence<Is...>) { 
+				return tuple_value_t{ copy< vtll::index_of<DATA, vtll::Nth_type<READ,Is>>::value >(block_ptr, n)... }; 
+			} (std::make_index_sequence<vtll::size<READ>::value>{});
+
+			std::atomic_thread_fence(std::memory_order_acquire); //the copies are done before the versions are loaded again
+			if( load_versions(std::memory_order_relaxed) != versions ) return std::nullopt;
+			return ret;
+		}
+
+		/// \brief Read a row, retry while pushes, pops or erases interfere. Does not wait for write views.
+		/// \param[in] n Index of the row.
+		/// \returns a tuple with copies of the components, or std::nullopt if the row does not exist or a write view holds a read column.
+		inline auto get(table_index_t n) noexcept -> std::optional<tuple_value_t> {
+			for( size_t i = 0; ; ++i ) {
+				if( auto ret = try_get(n) ) return ret;
+				if( n >= m_table.size() || view_writing() ) return std::nullopt;
+				if( i >= 64 ) std::this_thread::yield(); //a mutation is running
+			}
+		}
+
+	private:
+		using versions_t = std::array<uint64_t, vtll::size<READ>::value + 1>; ///< Versions of the read columns and of the rows
+
+		/// \brief Load the versions of all read columns and of the rows.
+		/// \returns the versions, or std::nullopt if a writer is active for any of them.
+		inline auto load_versions(std::memory_order order = std::memory_order_acquire) noexcept -> std::optional<versions_t> {
+			versions_t versions;
+			bool active = false;
+			vtll::static_for<size_t, 0, vtll::size<READ>::value >( [&](auto i) {
+				versions[i] = m_table.m_column_version[ vtll::index_of<DATA, vtll::Nth_type<READ, i>>::value ].m_value.load(order);
+				active = active || (versions[i] & table_type::VERSION_WRITERS) != 0;
+			});
+			versions.back() = m_table.m_row_version.m_value.load(order);
+			if( active || (versions.back() & table_type::VERSION_WRITERS) != 0 ) return std::nullopt;
+			return versions;
+		}
+
+		/// \brief Does a write view hold any of the read columns?
+		inline auto view_writing() noexcept -> bool {
+			bool writing = false;
+			vtll::static_for<size_t, 0, vtll::size<READ>::value >( [&](auto i) {
+				auto version = m_table.m_column_version[ vtll::index_of<DATA, vtll::Nth_type<READ, i>>::value ].m_value.load(std::memory_order_relaxed);
+				writing = writing || (version & table_type::VERSION_WRITERS) >= table_type::VERSION_VIEW;
+			});
+			return writing;
+		}
+
+		/// \brief Copy a component bytewise, it might be written to concurrently.
+		template<size_t I, typename C = vtll::Nth_type<DATA, I>>
+		inline auto copy(auto block_ptr, table_index_t n) noexcept -> C {
+			std::array<std::byte, sizeof(C)> bytes;
+			std::memcpy(bytes.data(), m_table.template get_component_ptr<I>(block_ptr, n), sizeof(C));
+			return std::bit_cast<C>(bytes);
+		}
+
 		table_type& m_table; ///< Reference to the table
+		VlltEpochGuard m_guard; ///< Keeps blocks alive as long as the view exists
 	};
 
 
@@ -878,10 +3301,11 @@ namespace vllt {
 	//table view iterator
 
 
-	template<typename DATA, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, typename READ, typename WRITELIST, typename WRITE>
+	template<typename LAYOUT, sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE, bool STATS, size_t ALIGN, typename READ, typename WRITELIST, typename WRITE>
 	class VtllStaticIterator : public VtllStaticIteratorBase {
 	public:
-		using view_type = VlltStaticTableView<DATA, SYNC, N0, ROW, MINSLOTS, FAIR, READ, WRITELIST>; ///< Type of the view	
+		using DATA = VlltColumns<LAYOUT>; ///< Types of the columns of the table
+		using view_type = VlltStaticTableView<LAYOUT, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS, ALIGN, READ, WRITELIST>; ///< Type of the view	
     	using difference_type = table_diff_t; ///< Type of the difference between two iterators
 		using value_type = vtll::to_tuple< vtll::cat< READ, WRITE > >; ///< Type of the value the iterator points to
    	 	using pointer = table_index_t; ///< Type of the pointer the iterator points to
@@ -948,47 +3372,192 @@ namespace vllt {
 	//---------------------------------------------------------------------------------------------------
 
 
-	/// \brief VlltStack is a simple stack on top of a VlltStaticTable.
+	#ifndef VLLT_ELIMINATION_SLOTS
+		#define VLLT_ELIMINATION_SLOTS 8	///< Number of slots in the elimination array of a VlltStack, 0 turns elimination off
+	#endif
+
+	#ifndef VLLT_ELIMINATION_SPINS
+		#define VLLT_ELIMINATION_SPINS 256	///< A push waits this many spins in the elimination array for a pop to take its value
+	#endif
+
+	#ifndef VLLT_ELIMINATION_TRIES
+		#define VLLT_ELIMINATION_TRIES 4	///< A contended push or pop tries table and elimination array this often, then it waits at the table
+	#endif
+
+	/// \brief Elimination array for a stack. A push that lost the race for the size counter of the table offers its value 
+	/// in a random slot. A pop that lost the race looks into a random slot and takes the value if there is one. Both 
+	/// operations are then done without touching the table, since a push followed by a pop leaves the stack unchanged.
+	/// Each slot is on its own cache line.
+	/// \tparam T Type of the values.
+	template<typename T>
+	class VlltElimination {
+		enum state_t : uint32_t { EMPTY = 0, BUSY, OFFERED, TAKING, TAKEN };
+
+	public:
+		/// \brief Offer a value to a concurrent pop, and wait VLLT_ELIMINATION_SPINS spins for it to be taken.
+		/// \param[in,out] data The value. If it was not taken, then it is moved back into data.
+		/// \returns true if a pop took the value.
+		inline auto push(T& data) noexcept -> bool {
+			auto& slot = m_slots[index()];
+			uint32_t state = EMPTY;
+			if( !slot.m_state.compare_exchange_strong(state, BUSY) ) return false;
+			std::construct_at( slot.m_value.data(), std::move(data) );
+			slot.m_state.store(OFFERED, std::memory_order_release);
+
+			for( size_t i = 0; i < VLLT_ELIMINATION_SPINS; ++i ) {
+				if( slot.m_state.load(std::memory_order_acquire) == TAKEN ) { slot.m_state.store(EMPTY, std::memory_order_release); return true; }
+			}
+
+			state = OFFERED;
+			if( slot.m_state.compare_exchange_strong(state, BUSY) ) { //withdraw the offer
+				data = std::move(*slot.m_value.data());
+				std::destroy_at(slot.m_value.data());
+				slot.m_state.store(EMPTY, std::memory_order_release);
+				return false;
+			}
+			while( slot.m_state.load(std::memory_order_acquire) != TAKEN ) {}; //a pop is moving the value out right now
+			slot.m_state.store(EMPTY, std::memory_order_release);
+			return true;
+		}
+
+		/// \brief Take a value that a concurrent push offers in a random slot.
+		/// \returns The value, or std::nullopt if the slot was not offering one.
+		inline auto pop() noexcept -> std::optional<T> {
+			auto& slot = m_slots[index()];
+			uint32_t state = OFFERED;
+			if( slot.m_state.load(std::memory_order_relaxed) != OFFERED || !slot.m_state.compare_exchange_strong(state, TAKING) ) return std::nullopt;
+			std::optional<T> ret{ std::move(*slot.m_value.data()) };
+			std::destroy_at(slot.m_value.data());
+			slot.m_state.store(TAKEN, std::memory_order_release);
+			return ret;
+		}
+
+	private:
+		/// \returns a random slot, using a xorshift generator per thread.
+		static inline auto index() noexcept -> size_t {
+			thread_local size_t seed = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+			seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+			return seed % VLLT_ELIMINATION_SLOTS;
+		}
+
+		struct alignas(64) slot_t {
+			std::atomic<uint32_t> m_state{EMPTY};	///< EMPTY -> BUSY -> OFFERED -> TAKING -> TAKEN -> EMPTY, or OFFERED -> BUSY -> EMPTY if withdrawn
+			VlltStorage<T, 1> m_value;				///< The offered value, constructed only between BUSY and TAKEN
+		};
+
+		std::array<slot_t, VLLT_ELIMINATION_SLOTS> m_slots;
+	};
+
+
+	//---------------------------------------------------------------------------------------------------
+
+
+	/// \brief VlltStack is a simple stack on top of a VlltStaticTable. If the size counter of the table is contended,
+	/// then pushes and pops meet in an elimination array and cancel each other out, see VlltElimination.
 	/// \tparam T Type being stored in the stack.
 	/// \tparam N0 SIze of blocks in the table.
 	/// \tparam ROW Boolean if the table is row based or column based.
 	/// \tparam MINSLOTS Minimum number of slots in a block.
 	/// \tparam FAIR If true then the stack will try to balance the number of pushes and pops.
+	/// \tparam STORAGE Storage engine that manages the blocks of the table.
+	/// \tparam STATS If true, the table counts contention and allocations, see stats().
 	/// \tparam SYNC In deug checks whether the stack is used concurrently with other views (which is not allowed).
-	template<typename T, size_t N0 = 1 << 5, bool ROW = false, size_t MINSLOTS = 16, bool FAIR = false>
+	template<typename T, size_t N0 = 1 << 5, bool ROW = false, size_t MINSLOTS = 16, bool FAIR = false, storage_t STORAGE = storage_t::VLLT_STORAGE_BLOCK_MAP, bool STATS = false>
 	class VlltStack {
 		using tuple_value_t = vtll::to_tuple<vtll::tl<T>>;	///< Tuple holding the entries as value
-		using table_type_t = VlltStaticTable<vtll::tl<T>, sync_t::VLLT_SYNC_EXTERNAL, N0, ROW, MINSLOTS, FAIR>;
-		using view_type_t = VlltStaticTableView<vtll::tl<T>, sync_t::VLLT_SYNC_EXTERNAL, N0, ROW, MINSLOTS, FAIR, vtll::tl<>, vtll::tl<T>>;
+		using table_type_t = VlltStaticTable<vtll::tl<T>, sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, N0, ROW, MINSLOTS, FAIR, STORAGE, STATS>;
+		static const bool ELIMINATION = VLLT_ELIMINATION_SLOTS > 0 && std::is_move_assignable_v<T>; ///< Withdrawn offers are moved back
 
 	public:
 		/// \brief Constructor of class VlltStaticStack
-		/// \param table Reference to the table
-		VlltStack(std::pmr::memory_resource* pmr = std::pmr::new_delete_resource() ) : m_table{ pmr } {};
+		/// \param pmr Memory resource for allocating blocks
+		/// \param block_cache_size Number of free blocks the stack keeps for reuse, see VlltStaticTable.
+		VlltStack(std::pmr::memory_resource* pmr = std::pmr::new_delete_resource(), size_t block_cache_size = VLLT_BLOCK_CACHE_SIZE ) 
+			: m_table{ pmr, block_cache_size } {};
 
 		inline auto size() noexcept { return m_table.size(); } ///< Return the number of rows in the table.
 
-		/// \brief Add a new row to the table.
-		/// \tparam ...Cs Types of the data to add.
-		/// \param ...data Data to add.
-		/// \returns Index of the new row.
+		inline auto stats() const noexcept -> VlltStats { return m_table.stats(); } ///< \returns the counters of the table, see VlltStaticTable::stats()
+
+		/// \brief Allocate all blocks needed for n values up front.
+		/// \param n Number of values.
+		/// \param pretouch If true, write to all pages of the new blocks.
+		/// \param pool If not nullptr, the pages are touched by the threads of this pool.
+		/// \throws std::length_error, std::bad_alloc VIRTUAL: if n is larger than VLLT_VIRTUAL_MAX_ROWS, or the pages could not be committed.
+		inline auto reserve(size_t n, bool pretouch = false, VlltThreadPool* pool = nullptr) -> void { m_table.reserve(n, pretouch, pool); }
+
+		/// Free all blocks after the last value and all cached blocks, see VlltStaticTable::shrink_to_fit().
+		inline auto shrink_to_fit() noexcept -> void { m_table.shrink_to_fit(); }
+
+		/// \brief Add a new row to the table. If the table is contended, the value may be handed to a concurrent pop instead.
+		/// \param data Data to add.
+		/// \returns Index of the new row, or an invalid index if a pop took the value directly.
 		inline auto push_back(T&& data) -> table_index_t { 
-			return m_view.push_back(std::forward<T>(data)); 
+			auto view = m_table.view(); //keeps the blocks alive
+			auto fill = [&](auto block_ptr, table_index_t n) { m_table.construct_row(block_ptr, n, std::move(data)); };
+			if constexpr (ELIMINATION) {
+				for( size_t i = 0; i < VLLT_ELIMINATION_TRIES; ++i ) {
+					if( auto idx = m_table.push_back_n_p(1, fill, true); idx.has_value() ) return idx;
+					if( m_elimination.push(data) ) return table_index_t{}; //the pop counts the pair
+				}
+			}
+			return m_table.push_back_n_p(1, fill); 
+		};
+
+		/// \brief Add num copies of a value to the stack, reserving the slots with as few atomic operations as possible.
+		/// \param num Number of copies.
+		/// \param data Value to copy.
+		/// \returns Index of the first new row.
+		inline auto push_back_n(size_t num, const T& data) -> table_index_t { 
+			return m_table.view().push_back_n(num, data); 
+		};
+
+		/// \brief Add all values of a range to the stack, reserving the slots with as few atomic operations as possible.
+		/// \param range Sized range of values.
+		/// \returns Index of the first new row.
+		template<std::ranges::sized_range R>
+		inline auto push_back_range(R&& range) -> table_index_t { 
+			return m_table.view().push_back_range( std::views::transform( std::forward<R>(range), [](auto&& data) { return std::forward_as_tuple(data); } ) ); 
 		};
 
 		/// Pop last row from the table.
-		/// \returnss Tuple with the data of the last row.
+		/// \returns Tuple with the data of the last row.
 		inline auto pop_back() noexcept -> std::optional< tuple_value_t > {
-			if( size() == 0 ) return std::nullopt;
+			VlltEpochGuard guard{ m_table.m_epoch }; //keeps the blocks alive
 			table_index_t n2;
-			auto ret = m_view.pop_back( &n2 );
+			if constexpr (ELIMINATION) {
+				for( size_t i = 0; i < VLLT_ELIMINATION_TRIES; ++i ) {
+					bool contended = false;
+					auto ret = m_table.pop_back( &n2, &contended, guard.slot() );
+					if( n2.has_value() ) return ret;
+					if( !contended ) return std::nullopt; //the stack is empty
+					if( auto value = m_elimination.pop() ) { 
+						m_table.m_stats.add(table_type_t::stats_t::ELIMINATIONS); 
+						return tuple_value_t{ std::move(*value) }; 
+					}
+				}
+			}
+			if( size() == 0 ) return std::nullopt;
+			auto ret = m_table.pop_back( &n2, nullptr, guard.slot() );
 			if( n2.has_value() ) return ret;
 			return std::nullopt; 
 		};
 
+		/// \brief Pop up to num rows with a single atomic operation on the size counter.
+		/// \param num Maximal number of rows to pop.
+		/// \param out Output iterator receiving the values as tuple_value_t, last row first.
+		/// \returns Number of popped rows.
+		template<typename It>
+		inline auto pop_back_n(size_t num, It out) noexcept -> size_t { 
+			return m_table.view().pop_back_n(num, out); 
+		};
+
+		/// Remove all rows from the stack. \returns Number of removed rows.
+		inline auto clear() noexcept -> size_t { return m_table.view().clear(); };
+
 	private:
 		table_type_t m_table; ///< the table used by the stack
-		view_type_t m_view = m_table.view(); ///< view to the table
+		[[no_unique_address]] std::conditional_t<ELIMINATION, VlltElimination<T>, std::monostate> m_elimination; ///< pushes and pops meet here if the table is contended
 	};
 
 
@@ -996,3 +3565,11 @@ namespace vllt {
 }
 
 
+/// Structured bindings for view groups
+template<typename... VIEWS>
+struct std::tuple_size<vllt::VlltViewGroup<VIEWS...>> : std::integral_constant<size_t, sizeof...(VIEWS)> {};
+
+template<size_t I, typename... VIEWS>
+struct std::tuple_element<I, vllt::VlltViewGroup<VIEWS...>> { using type = vtll::Nth_type<vtll::tl<VIEWS...>, I>; };
+
+
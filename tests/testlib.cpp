@@ -5,6 +5,15 @@
 
 using namespace std::chrono; 
 
+int num_failed = 0; ///< Number of failed checks, returned by main()
+
+/// @brief Count and report a failed check. Unlike assert(), this also works in release builds.
+void check(bool ok, const char* what) {
+	if( ok ) return;
+	std::cout << "FAILED: " << what << std::endl;
+	++num_failed;
+}
+
 
 void functional_test() {
 
@@ -12,6 +21,612 @@ void functional_test() {
 }
 
 
+/// @brief A single view that keeps pushing and popping over block boundaries recycles its own blocks through the cache.
+void block_cache_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_BLOCK_MAP, true>;
+
+	auto oscillate = [](table_t& table) {
+		auto view = table.view();
+		for( int r = 0; r < 1000; ++r ) {
+			for( int i = 0; i < 128; ++i ) view.push_back(int{i});
+			for( int i = 0; i < 128; ++i ) view.pop_back();
+		}
+	};
+
+	{
+		table_t table{ std::pmr::new_delete_resource(), 4 };
+		oscillate(table);
+		auto stats = table.stats();
+		check( stats.m_blocks_allocated <= 4, "block cache: blocks are allocated only once" );
+		check( stats.m_blocks_recycled >= 1000, "block cache: popped blocks are recycled by the popping view" );
+		check( stats.m_blocks_freed == 0, "block cache: no block goes back to the memory resource" );
+		table.shrink_to_fit();
+		check( table.stats().m_blocks_freed == table.stats().m_blocks_allocated, "block cache: shrink_to_fit() frees all blocks" );
+	}
+
+	{
+		table_t table{ std::pmr::new_delete_resource(), 0 }; //cache turned off
+		oscillate(table);
+		auto stats = table.stats();
+		check( stats.m_blocks_recycled == 0, "block cache off: nothing is recycled" );
+		check( stats.m_blocks_allocated - stats.m_blocks_freed <= 2, "block cache off: popped blocks are freed" ); //the table keeps two empty blocks
+	}
+
+	{
+		table_t table;
+		{
+			auto reader = table.optimistic_view<int>(); //an older view might still access removed blocks
+			oscillate(table);
+			check( table.stats().m_blocks_recycled == 0, "block cache: blocks are not recycled while an older view exists" );
+		}
+		auto stats = table.stats(); //two empty blocks stay in the table, four go into the cache
+		check( stats.m_blocks_allocated - stats.m_blocks_freed <= 2 + 4, "block cache: blocks are freed when the older view is gone" );
+	}
+}
+
+
+
+/// @brief Bulk pushes add consecutive rows and return the first of them.
+void push_n_test() {
+	vllt::VlltStaticTable<vtll::tl<int, std::string>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 32> table;
+	auto view = table.view();
+
+	check( view.push_back_n(100, 7, std::string("x")) == vllt::table_index_t{0}, "push_back_n: returns the first new row" );
+	std::vector<std::tuple<int, std::string>> rows;
+	for( int i = 0; i < 200; ++i ) rows.emplace_back(i, std::to_string(i));
+	check( view.push_back_range(rows) == vllt::table_index_t{100}, "push_back_range: returns the first new row" );
+	check( view.size() == 300, "push_back_n, push_back_range: all rows are added" );
+
+	bool ok = true;
+	for( int i = 0; i < 300; ++i ) {
+		auto [n, str] = view.get_ref_tuple( vllt::table_index_t{(size_t)i} );
+		ok &= i < 100 ? (n == 7 && str == "x") : (n == i - 100 && str == std::to_string(i - 100));
+	}
+	check( ok, "push_back_n, push_back_range: rows have the right values in the right order" );
+
+	vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 1 << 12> big;
+	const int num_threads = 128, num = 3 * 4096; //more concurrent reservations than the diff of the size counter can hold
+	{
+		std::vector<std::jthread> threads;
+		for( int t = 0; t < num_threads; ++t ) threads.emplace_back( [&, t]() { big.view<vllt::VlltWrite>().push_back_n(num, int{t}); } );
+	}
+	std::vector<int> count(num_threads, 0);
+	auto bview = big.view<int>();
+	for( size_t i = 0; i < bview.size(); ++i ) ++count[ std::get<0>(bview.get_ref_tuple(vllt::table_index_t{i})) ];
+	check( big.size() == (size_t)num_threads * num && std::ranges::all_of(count, [&](int c) { return c == num; }), "push_back_n: concurrent bulk pushes add all rows" );
+}
+
+
+/// @brief Bulk pops return the rows last first, truncate keeps a prefix.
+void pop_n_test() {
+	vllt::VlltStaticTable<vtll::tl<int, std::string>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 32> table;
+	auto view = table.view();
+	for( int i = 0; i < 300; ++i ) view.push_back(int{i}, std::to_string(i));
+
+	std::vector<std::tuple<int, std::string>> removed;
+	check( view.pop_back_n(10, std::back_inserter(removed)) == 10 && view.size() == 290, "pop_back_n: removes the rows" );
+	check( removed.size() == 10 && std::get<0>(removed.front()) == 299 && std::get<0>(removed.back()) == 290, "pop_back_n: moves out the values last row first" );
+	check( std::get<1>(removed.front()) == "299", "pop_back_n: moves out all columns" );
+	check( view.pop_back_n(1000) == 290 && view.size() == 0, "pop_back_n: removes at most all rows" );
+
+	for( int i = 0; i < 50; ++i ) view.push_back(int{i}, std::string("y"));
+	view.truncate(5);
+	check( view.size() == 5 && std::get<1>(view.get_ref_tuple(vllt::table_index_t{4})) == "y", "truncate: keeps the first rows" );
+	view.truncate(10);
+	check( view.size() == 5, "truncate: does not add rows" );
+	view.clear();
+	check( view.size() == 0, "clear: removes all rows" );
+}
+
+
+/// @brief Minimal eagerly started coroutine type, for testing async_view().
+struct task_t {
+	struct promise_type {
+		auto get_return_object() noexcept -> task_t { return {}; }
+		auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+		auto final_suspend() noexcept -> std::suspend_never { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+
+/// @brief try_view() never blocks, async_view() parks a coroutine until the conflicting view is gone.
+void try_async_view_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int, float>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32>;
+	table_t table;
+	table.view().push_back(1, 1.0f);
+
+	{
+		auto writer = table.view<vllt::VlltWrite, int>();
+		check( !table.try_view<vllt::VlltWrite, int>().has_value(), "try_view: fails if a column is written by another view" );
+		check( !table.try_view<int>().has_value(), "try_view: fails if a read column is written by another view" );
+		check( table.try_view<float>().has_value(), "try_view: succeeds for other columns" );
+	}
+	check( table.try_view<vllt::VlltWrite, int>().has_value(), "try_view: succeeds when the other view is gone" );
+
+	int step = 0;
+	auto system = [&](table_t& t) -> task_t {
+		auto view = co_await t.async_view<vllt::VlltWrite, int>();
+		std::get<0>(view.get_ref_tuple(vllt::table_index_t{0})) = 2;
+		step = 1;
+	};
+
+	system(table);
+	check( step == 1, "async_view: does not suspend if the columns are free" );
+
+	step = 0;
+	{
+		auto writer = table.view<vllt::VlltWrite, int>();
+		system(table);
+		check( step == 0, "async_view: suspends while a column is locked" );
+	}
+	check( step == 1, "async_view: the coroutine is resumed when the conflicting view is destroyed" );
+	check( table.try_view<vllt::VlltWrite, int, float>().has_value(), "async_view: the view of the resumed coroutine releases its columns" );
+}
+
+
+/// @brief acquire() locks the columns of several tables together, and releases them with the group.
+void acquire_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int, float>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32>;
+	table_t t1, t2;
+	t1.view().push_back(1, 1.0f);
+	t2.view().push_back(2, 2.0f);
+
+	{
+		auto [v1, v2] = vllt::acquire( t1.spec<vllt::VlltWrite, int>(), t2.spec<float>() );
+		std::get<0>(v1.get_ref_tuple(vllt::table_index_t{0})) = std::get<0>(v2.get_ref_tuple(vllt::table_index_t{0})) == 2.0f ? 3 : 0;
+		check( !t1.try_view<int>().has_value(), "acquire: the write column is locked" );
+		check( t1.try_view<float>().has_value(), "acquire: other columns are free" );
+		check( t2.try_view<float>().has_value() && !t2.try_view<vllt::VlltWrite, float>().has_value(), "acquire: the read column is shared" );
+	}
+	check( t1.try_view<vllt::VlltWrite, int, float>().has_value() && t2.try_view<vllt::VlltWrite, int, float>().has_value(), "acquire: all columns are released" );
+	check( std::get<0>(t1.view<int>().get_ref_tuple(vllt::table_index_t{0})) == 3, "acquire: the views access the right tables" );
+}
+
+
+/// @brief Systems that conflict run in the order they were added, others are independent.
+void scheduler_test() {
+	vllt::VlltStaticTable<vtll::tl<int, float>, vllt::sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 32> t1;
+	vllt::VlltStaticTable<vtll::tl<double>, vllt::sync_t::VLLT_SYNC_EXTERNAL, 32> t2;
+	t1.view().push_back_n(100, 0, 0.0f);
+	t2.view().push_back_n(100, 0.0);
+
+	vllt::VlltThreadPool pool{2};
+	vllt::VlltScheduler scheduler{ pool };
+	int sum = 0;
+	double dsum = 0.0;
+	scheduler.add( [](auto& v) { for( size_t i = 0; i < v.size(); ++i ) std::get<0>(v.get_ref_tuple(vllt::table_index_t{i})) += 1; }, t1.spec<vllt::VlltWrite, int>() );
+	scheduler.add( [&](auto& v) { sum = 0; for( size_t i = 0; i < v.size(); ++i ) sum += std::get<0>(v.get_ref_tuple(vllt::table_index_t{i})); }, t1.spec<int>() );
+	scheduler.add( [&](auto& v1, auto& v2) { 
+		double fsum = 0.0;
+		for( size_t i = 0; i < v1.size(); ++i ) fsum += std::get<0>(v1.get_ref_tuple(vllt::table_index_t{i}));
+		dsum = (std::get<0>(v2.get_ref_tuple(vllt::table_index_t{0})) += fsum);
+	}, t1.spec<float>(), t2.spec<vllt::VlltWrite, double>() );
+	scheduler.add( [](auto& v) { v.push_back(0, 1.0f); }, t1.spec<vllt::VlltWrite>() );
+
+	check( scheduler.size() == 4, "scheduler: all systems are added" );
+	check( scheduler.conflict(0, 1) && !scheduler.conflict(0, 2) && !scheduler.conflict(1, 2), "scheduler: conflicts are per column" );
+	check( scheduler.conflict(1, 3) && scheduler.conflict(2, 3), "scheduler: a pushback-only view conflicts with all columns" );
+
+	scheduler.run();
+	check( sum == 100 && dsum == 0.0 && t1.size() == 101, "scheduler: the first run keeps the order of conflicting systems" );
+	scheduler.run();
+	check( sum == 2 * 100 + 1 && dsum == 1.0 && t1.size() == 102, "scheduler: systems run again in the same order" );
+}
+
+
+/// @brief Values are neither lost nor duplicated when pushes and pops meet in the elimination array.
+void stack_test() {
+	{
+		vllt::VlltElimination<int> elimination;
+		check( !elimination.pop().has_value(), "elimination: nothing to take without a push" );
+		int value = 5;
+		check( !elimination.push(value) && value == 5, "elimination: a withdrawn offer is moved back" );
+		check( !elimination.pop().has_value(), "elimination: a withdrawn offer is gone" );
+	}
+
+	vllt::VlltStack<int, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_BLOCK_MAP, true> stack;
+	const int num_threads = 4, num = 20000;
+	std::atomic<int64_t> popped_sum{0};
+	std::atomic<size_t> eliminated{0};
+	{
+		std::vector<std::jthread> threads;
+		for( int t = 0; t < num_threads; ++t ) {
+			threads.emplace_back( [&, t]() {
+				int64_t sum = 0;
+				size_t elim = 0;
+				for( int i = 0; i < num; ++i ) {
+					if( !stack.push_back(t * num + i + 1).has_value() ) ++elim; //eliminated by a pop
+					if( i % 2 == 1 ) {
+						if( auto v = stack.pop_back() ) sum += std::get<0>(*v);
+						if( auto v = stack.pop_back() ) sum += std::get<0>(*v);
+					}
+				}
+				popped_sum += sum;
+				eliminated += elim;
+			});
+		}
+	}
+	while( auto v = stack.pop_back() ) popped_sum += std::get<0>(*v);
+
+	int64_t n = (int64_t)num_threads * num;
+	check( popped_sum == n * (n + 1) / 2, "stack: every pushed value is popped exactly once" );
+	check( stack.size() == 0, "stack: all values are popped" );
+	check( stack.stats().m_eliminations == eliminated, "stack: every eliminated push is counted" );
+}
+
+
+/// @brief Grouped columns are stored interleaved, but accessed like all other columns.
+void column_group_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<vtll::tl<float, double>, int>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32>;
+	static_assert( std::is_same_v<table_t::DATA, vtll::tl<float, double, int>> );
+	table_t table;
+
+	{
+		auto view = table.view();
+		for( int i = 0; i < 100; ++i ) view.push_back((float)i, 2.0 * i, 3 * i);
+		auto [f, d, n] = view.get_ref_tuple(vllt::table_index_t{42});
+		check( f == 42.0f && d == 84.0 && n == 126, "column groups: rows are stored and read in the flattened order" );
+		auto [f1, d1, n1] = view.get_ref_tuple(vllt::table_index_t{43});
+		check( (char*)&d1 - (char*)&f1 == (char*)&d - (char*)&f, "column groups: grouped columns are interleaved" );
+		check( &n1 == &n + 1, "column groups: other columns are contiguous" );
+
+		auto [fe, de, ne] = view.erase(vllt::table_index_t{0});
+		check( fe == 0.0f && view.size() == 99 && std::get<2>(view.get_ref_tuple(vllt::table_index_t{0})) == 3 * 99, "column groups: erase moves the last row" );
+	}
+
+	int64_t sum = 0;
+	table.view<int>().for_each_block( [&](vllt::table_index_t, std::span<const int> n) { for( auto v : n ) sum += v; } );
+	check( sum == 3 * 99 * 100 / 2, "column groups: columns outside of groups have spans" );
+
+	{
+		auto reader = table.view<double>();
+		check( table.try_view<vllt::VlltWrite, float>().has_value(), "column groups: columns of a group are locked separately" );
+	}
+}
+
+
+/// @brief Append-only tables claim slots with fetch_add and publish every row exactly once.
+void append_only_test() {
+	vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL_APPEND_ONLY, 32> table;
+	const int num_threads = 4, num = 10000;
+	{
+		std::vector<std::jthread> threads;
+		for( int t = 0; t < num_threads; ++t ) {
+			threads.emplace_back( [&, t]() {
+				if( t % 2 == 0 ) {
+					auto view = table.view<vllt::VlltWrite>();
+					for( int i = 0; i < num; ++i ) view.push_back(t * num + i);
+				} else {
+					auto view = table.view<vllt::VlltWrite, vllt::VlltChunk>();
+					for( int i = 0; i < num; ++i ) view.push_back(t * num + i);
+				}
+			});
+		}
+	}
+	check( table.size() == num_threads * num, "append-only: all rows are committed" );
+
+	std::vector<bool> seen(num_threads * num, false);
+	bool ok = true;
+	auto view = table.view<int>();
+	for( size_t i = 0; i < view.size(); ++i ) {
+		auto v = std::get<0>(view.get_ref_tuple(vllt::table_index_t{i}));
+		ok &= v >= 0 && v < num_threads * num && !seen[v];
+		if( ok ) seen[v] = true;
+	}
+	check( ok, "append-only: every row is stored exactly once" );
+}
+
+
+/// @brief Chunked pushback-only views buffer rows locally, so columns need no default constructor.
+void chunk_test() {
+	struct handle_t { int m_id; explicit handle_t(int id) : m_id{id} {} };
+	vllt::VlltStaticTable<vtll::tl<handle_t, int>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 32> table;
+	{
+		auto view = table.view<vllt::VlltWrite, vllt::VlltChunk>();
+		check( !view.emplace_back(0, 0).has_value(), "chunked view: emplace_back only buffers the row" );
+		for( int i = 1; i < 40; ++i ) view.emplace_back(i, i);
+		check( table.size() == 32, "chunked view: a full chunk is added to the table" );
+		check( view.flush() == vllt::table_index_t{32}, "chunked view: flush adds the rest and returns its first row" );
+		view.emplace_back(40, 40);
+	}
+	check( table.size() == 41, "chunked view: the destructor flushes" );
+	bool ok = true;
+	auto view = table.view<handle_t, int>();
+	for( size_t i = 0; i < view.size(); ++i ) {
+		auto [h, n] = view.get_ref_tuple(vllt::table_index_t{i});
+		ok &= h.m_id == (int)i && n == (int)i;
+	}
+	check( ok, "chunked view: rows are added in the order they were pushed" );
+}
+
+
+/// @brief More views than epoch slots share the overflow slot instead of waiting, and still protect retired blocks.
+void epoch_overflow_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_BLOCK_MAP, true>;
+	using reader_t = decltype(std::declval<table_t&>().optimistic_view<int>());
+	table_t table{ std::pmr::new_delete_resource(), 0 };
+	{
+		std::vector<std::unique_ptr<reader_t>> readers;
+		for( size_t i = 0; i < 2 * VLLT_MAX_NUMBER_OF_EPOCH_SLOTS; ++i ) readers.push_back( std::make_unique<reader_t>(table) );
+		auto view = table.view();
+		for( int i = 0; i < 1000; ++i ) view.push_back(int{i});
+		for( int i = 0; i < 1000; ++i ) view.pop_back();
+		check( table.stats().m_blocks_freed == 0, "epoch overflow: removed blocks are not freed while older views exist" );
+		check( readers.back()->try_get(vllt::table_index_t{0}) == std::nullopt, "epoch overflow: views in the overflow slot work" );
+	}
+	auto stats = table.stats();
+	check( stats.m_blocks_allocated - stats.m_blocks_freed <= 2, "epoch overflow: blocks are freed when the overflow slot is released" );
+}
+
+
+/// @brief A segmented table grows by adding segments, so blocks never move and no block map is copied.
+void segmented_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 32, false, 1, false, vllt::storage_t::VLLT_STORAGE_SEGMENTED, true>;
+	table_t table;
+	int* first{};
+	{
+		auto view = table.view();
+		view.push_back(0);
+		first = &std::get<0>(view.get_ref_tuple(vllt::table_index_t{0}));
+		for( int i = 1; i < 32 * 64; ++i ) view.push_back(int{i}); //64 blocks in segments of 1, 2, 4, ..., 32 blocks
+		bool ok = true;
+		for( size_t i = 0; i < view.size(); ++i ) ok &= std::get<0>(view.get_ref_tuple(vllt::table_index_t{i})) == (int)i;
+		check( ok, "segmented: rows keep their values across segment boundaries" );
+	}
+
+	const int num_threads = 8, num = 5000;
+	{
+		std::vector<std::jthread> threads;
+		for( int t = 0; t < num_threads; ++t ) threads.emplace_back( [&, t]() { 
+			auto view = table.view<vllt::VlltWrite>();
+			for( int i = 0; i < num; ++i ) view.push_back(-1 - t);
+		});
+	}
+	check( table.size() == 32 * 64 + num_threads * num, "segmented: concurrent pushes add all rows" );
+	std::vector<int> count(num_threads, 0);
+	auto view = table.view<int>();
+	for( size_t i = 32 * 64; i < view.size(); ++i ) {
+		auto v = std::get<0>(view.get_ref_tuple(vllt::table_index_t{i}));
+		if( v < 0 && v >= -num_threads ) ++count[-1 - v];
+	}
+	check( std::ranges::all_of(count, [&](int c) { return c == num; }), "segmented: every concurrent push is stored once" );
+	check( &std::get<0>(view.get_ref_tuple(vllt::table_index_t{0})) == first && *first == 0, "segmented: rows do not move when segments are added" );
+	check( table.stats().m_map_grows == 0, "segmented: the directory never grows" );
+}
+
+
+/// @brief Columns of a virtual table are contiguous arrays that never move, pages are committed as the table grows.
+void virtual_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int, double>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_VIRTUAL, false, 256>;
+	table_t table;
+	auto view = table.view();
+	view.push_back(0, 0.0);
+	int* first = &std::get<0>(view.get_ref_tuple(vllt::table_index_t{0}));
+	for( int i = 1; i < 1000; ++i ) view.push_back(int{i}, 2.0 * i);
+
+	bool ok = true;
+	for( size_t i = 0; i < 1000; ++i ) ok &= &std::get<0>(view.get_ref_tuple(vllt::table_index_t{i})) == first + i;
+	check( ok, "virtual: rows are stored at base + n over block boundaries" );
+	check( *first == 0 && std::get<1>(view.get_ref_tuple(vllt::table_index_t{999})) == 1998.0, "virtual: rows keep their values while the table grows" );
+
+	int calls = 0;
+	view.for_each_block( [&](vllt::table_index_t n, std::span<int> a, std::span<double> b) {
+		++calls;
+		check( n == vllt::table_index_t{0} && a.data() == first && a.size() == 1000 && b.size() == 1000, "virtual: the span covers all rows" );
+		check( view.padded_size(a) == 1024 && view.padded_size(b) == 1024, "virtual: spans are padded to the alignment" );
+	});
+	check( calls == 1, "virtual: for_each_block calls its function once" );
+
+	table_t small;
+	auto sview = small.view();
+	for( int i = 0; i < 32; ++i ) sview.push_back(int{i}, 0.0);
+	sview.for_each_block( [&](vllt::table_index_t, std::span<int> a, std::span<double>) {
+		check( sview.padded_size(a) == 32, "virtual: padded_size stops at the committed rows" );
+	});
+	sview.push_back(32, 0.0);
+	sview.for_each_block( [&](vllt::table_index_t, std::span<int> a, std::span<double>) {
+		check( sview.padded_size(a) == 64, "virtual: pages are committed for twice as many rows" );
+	});
+
+	bool thrown = false;
+	try { small.reserve(VLLT_VIRTUAL_MAX_ROWS + 1); } catch( const std::length_error& ) { thrown = true; }
+	check( thrown, "virtual: reserving more than VLLT_VIRTUAL_MAX_ROWS rows throws" );
+}
+
+
+/// @brief Optimistic views copy rows without locks, and retry or give up while writers are active.
+void optimistic_view_test() {
+	vllt::VlltStaticTable<vtll::tl<int, double>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32> table;
+	{
+		auto view = table.view();
+		for( int i = 0; i < 100; ++i ) view.push_back(int{i}, 2.0 * i);
+	}
+
+	auto reader = table.optimistic_view<int, double>();
+	check( reader.get(vllt::table_index_t{5}) == std::make_tuple(5, 10.0), "optimistic view: get copies the row" );
+	check( reader.try_get(vllt::table_index_t{99}) == std::make_tuple(99, 198.0), "optimistic view: try_get copies the row" );
+	check( !reader.get(vllt::table_index_t{100}).has_value(), "optimistic view: rows past the end do not exist" );
+
+	{
+		auto writer = table.view<vllt::VlltWrite, int>();
+		std::get<0>(writer.get_ref_tuple(vllt::table_index_t{5})) = 50;
+		check( !reader.get(vllt::table_index_t{5}).has_value(), "optimistic view: a write view holding a column makes reads fail" );
+		check( table.optimistic_view<double>().get(vllt::table_index_t{5}) == std::make_tuple(10.0), "optimistic view: other columns can still be read" );
+	}
+	check( reader.get(vllt::table_index_t{5}) == std::make_tuple(50, 10.0), "optimistic view: reads succeed after the write view is gone" );
+
+	std::atomic<bool> stop{false};
+	std::jthread mutator( [&]() {
+		auto view = table.view();
+		while( !stop.load() ) {
+			for( int i = 0; i < 64; ++i ) view.push_back(100 + i, 2.0 * (100 + i));
+			for( int i = 0; i < 64; ++i ) view.pop_back();
+		}
+	});
+	bool ok = true;
+	for( int r = 0; r < 20000; ++r ) {
+		auto n = vllt::table_index_t{ (size_t)(r % 150) };
+		auto row = reader.get(n);
+		if( (size_t)n < 100 ) ok &= row.has_value(); //rows below 100 are never removed
+		if( row ) ok &= std::get<1>(*row) == 2.0 * std::get<0>(*row) || (size_t)n == 5;
+	}
+	stop = true;
+	check( ok, "optimistic view: reads retry while rows are pushed and popped, and never see torn rows" );
+}
+
+
+/// @brief Column locks exclude writers from readers and other writers, and a waiting writer holds back new readers.
+template<typename L>
+void lock_test(const char* name) {
+	auto check_lock = [&](bool ok, const char* what) { check( ok, (std::string(name) + ": " + what).c_str() ); };
+	L lock;
+	size_t token;
+	auto reader = lock.lock_shared();
+	check_lock( !lock.try_lock(), "a reader excludes writers" );
+	check_lock( lock.try_lock_shared(token), "readers share the lock" );
+	lock.unlock_shared(token);
+
+	std::atomic<bool> locked{false};
+	std::jthread writer( [&]() { lock.lock(); locked = true; lock.unlock(); } );
+	while( lock.try_lock_shared(token) ) { lock.unlock_shared(token); std::this_thread::yield(); } //until the writer waits
+	check_lock( !locked.load(), "the writer waits for the reader" );
+	lock.unlock_shared(reader);
+	writer.join();
+	check_lock( locked.load(), "the writer gets the lock when the reader leaves" );
+
+	lock.lock();
+	check_lock( !lock.try_lock_shared(token) && !lock.try_lock(), "a writer excludes readers and writers" );
+	lock.unlock();
+	check_lock( lock.try_lock(), "the lock is free after the writer leaves" );
+	lock.unlock();
+}
+
+
+/// @brief A BRAVO lock lets readers take the fast path, writers revoke it, and readers turn it on again later.
+void bravo_lock_test() {
+	vllt::VlltBravoLock lock;
+	auto token = lock.lock_shared();
+	check( token != 0, "bravo lock: readers take the fast path while the lock is biased" );
+	lock.unlock_shared(token);
+
+	lock.lock();
+	lock.unlock();
+	token = lock.lock_shared();
+	check( token == 0, "bravo lock: a writer revokes the bias" );
+	lock.unlock_shared(token);
+
+	std::this_thread::sleep_for(milliseconds(1));
+	for( int i = 0; i < 2; ++i ) { token = lock.lock_shared(); lock.unlock_shared(token); }
+	check( token != 0, "bravo lock: readers turn the bias on again" );
+}
+
+
+/// @brief parallel_for_each calls the function exactly once for each row, also for a partly filled last block.
+void parallel_for_each_test() {
+	vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32> table;
+	vllt::VlltThreadPool pool{3};
+	std::atomic<int> calls{0};
+	table.view().parallel_for_each( [&](auto) { ++calls; }, pool );
+	check( calls == 0, "parallel_for_each: an empty table calls nothing" );
+
+	auto view = table.view();
+	for( int i = 0; i < 1000; ++i ) view.push_back(int{i});
+	view.parallel_for_each( [&](auto row) { std::get<0>(row) *= 2; ++calls; }, pool );
+	check( calls == 1000, "parallel_for_each: the function is called once per row" );
+	bool ok = true;
+	for( size_t i = 0; i < view.size(); ++i ) ok &= std::get<0>(view.get_ref_tuple(vllt::table_index_t{i})) == 2 * (int)i;
+	check( ok, "parallel_for_each: every row is changed once" );
+}
+
+
+/// @brief Page resources reuse freed blocks, and fall back to normal memory if the OS refuses the policy.
+void page_resource_test() {
+	{
+		vllt::VlltPageResource resource;
+		auto p1 = resource.allocate(1000, 64);
+		auto p2 = resource.allocate(1000, 64);
+		check( (size_t)std::abs((char*)p2 - (char*)p1) < VLLT_PAGE_CHUNK_SIZE, "page resource: small allocations share a chunk" );
+		resource.deallocate(p1, 1000, 64);
+		check( resource.allocate(1000, 64) == p1, "page resource: freed memory is reused for the same size" );
+		auto big = resource.allocate(VLLT_PAGE_CHUNK_SIZE, 64);
+		check( reinterpret_cast<uintptr_t>(big) % VLLT_HUGE_PAGE_SIZE == 0, "page resource: big allocations get their own aligned chunk" );
+		check( !resource.huge_pages() && !resource.numa_bound(), "page resource: the default policy asks for nothing" );
+	}
+	{
+		vllt::VlltNumaResource resource{ 1 << 20 }; //there is no such node
+		vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL, 1 << 10> table{ &resource };
+		table.view().push_back_n(5000, 7);
+		check( !resource.numa_bound(), "numa resource: binding to a missing node falls back to normal memory" );
+		check( table.size() == 5000 && std::get<0>(table.view<int>().get_ref_tuple(vllt::table_index_t{4999})) == 7, "numa resource: tables work without binding" );
+	}
+	{
+		vllt::VlltHugePageResource huge;
+		vllt::VlltFirstTouchResource touch;
+		auto p = static_cast<int*>( huge.allocate(sizeof(int) * 1000, alignof(int)) );
+		auto q = static_cast<int*>( touch.allocate(sizeof(int) * 1000, alignof(int)) );
+		p[999] = q[999] = 1;
+		check( p[999] == 1 && q[999] == 1 && huge.policy().m_huge_pages && touch.policy().m_first_touch, "huge page and first touch resources hand out usable memory" );
+	}
+}
+
+
+/// @brief With ALIGN, every span starts at the alignment, and padded_size() covers the padding behind the last row.
+void align_test() {
+	vllt::VlltStaticTable<vtll::tl<char, double>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_BLOCK_MAP, false, 64> table;
+	auto view = table.view();
+	for( int i = 0; i < 70; ++i ) view.push_back((char)i, 1.0 * i);
+
+	bool aligned = true, padded = true;
+	view.for_each_block( [&](vllt::table_index_t, std::span<char> c, std::span<double> d) {
+		aligned &= reinterpret_cast<uintptr_t>(c.data()) % 64 == 0 && reinterpret_cast<uintptr_t>(d.data()) % 64 == 0;
+		padded &= view.padded_size(c) == (c.size() + 63) / 64 * 64 && view.padded_size(d) == (d.size() + 7) / 8 * 8;
+	});
+	check( aligned, "align: spans start at the alignment of the table" );
+	check( padded, "align: padded_size rounds up to the alignment" );
+
+	vllt::VlltStaticTable<vtll::tl<char>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32> natural;
+	auto nview = natural.view();
+	nview.push_back_n(10, 'a');
+	nview.for_each_block( [&](vllt::table_index_t, std::span<char> c) {
+		check( nview.padded_size(c) == 10, "align: without ALIGN there is no padding" );
+	});
+}
+
+
+/// @brief emplace_back constructs each component in place, so columns need neither a default constructor nor a copy.
+void emplace_test() {
+	struct handle_t { int m_id; explicit handle_t(int id) : m_id{id} {} };
+	vllt::VlltStaticTable<vtll::tl<handle_t, std::unique_ptr<int>>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32> table;
+	auto view = table.view();
+	for( int i = 0; i < 40; ++i ) check( view.emplace_back(i, new int{2 * i}) == vllt::table_index_t{(size_t)i}, "emplace_back: returns the index of the new row" );
+
+	bool ok = true;
+	for( size_t i = 0; i < view.size(); ++i ) {
+		auto [h, p] = view.get_ref_tuple(vllt::table_index_t{i});
+		ok &= h.m_id == (int)i && *p == 2 * (int)i;
+	}
+	check( ok, "emplace_back: components are constructed from the arguments" );
+}
+
+
+/// @brief After reserve(), adding rows allocates no blocks and does not grow the block map.
+void reserve_test() {
+	using table_t = vllt::VlltStaticTable<vtll::tl<int>, vllt::sync_t::VLLT_SYNC_INTERNAL, 32, false, 16, false, vllt::storage_t::VLLT_STORAGE_BLOCK_MAP, true>;
+	vllt::VlltThreadPool pool{2};
+	for( auto p : { (vllt::VlltThreadPool*)nullptr, &pool } ) {
+		table_t table;
+		table.reserve(1000, true, p);
+		auto stats = table.stats();
+		check( stats.m_blocks_allocated == 1000 / 32 + 1, "reserve: all blocks are allocated up front" );
+
+		auto view = table.view();
+		for( int i = 0; i < 1000; ++i ) view.push_back(int{i});
+		check( table.stats().m_blocks_allocated == stats.m_blocks_allocated && table.stats().m_map_grows == stats.m_map_grows, "reserve: pushes into reserved blocks allocate nothing" );
+		check( std::get<0>(view.get_ref_tuple(vllt::table_index_t{999})) == 999, "reserve: rows are stored in the reserved blocks" );
+	}
+}
 
 
 //------------------------------------------------------------------------------------------
@@ -251,7 +866,30 @@ int main() {
 	std::cout << std::thread::hardware_concurrency() << " Threads" << std::endl;
 	//functional_test_static();
 	//parallel_test_static<vllt::sync_t::VLLT_SYNC_DEBUG_PUSHBACK>( );
-	return 0;
+	block_cache_test();
+	push_n_test();
+	pop_n_test();
+	try_async_view_test();
+	acquire_test();
+	scheduler_test();
+	stack_test();
+	column_group_test();
+	append_only_test();
+	chunk_test();
+	epoch_overflow_test();
+	segmented_test();
+	virtual_test();
+	optimistic_view_test();
+	lock_test<vllt::VlltRWLock>("rw lock");
+	lock_test<vllt::VlltBravoLock>("bravo lock");
+	bravo_lock_test();
+	parallel_for_each_test();
+	page_resource_test();
+	align_test();
+	emplace_test();
+	reserve_test();
+	std::cout << (num_failed == 0 ? "All tests passed" : "Some tests failed") << std::endl;
+	return num_failed == 0 ? 0 : 1;
 }
 
 
@@ -0,0 +1,297 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <latch>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "VLLT.h"
+
+using namespace std::chrono;
+using namespace vllt;
+
+
+//------------------------------------------------------------------------------------------
+//Benchmark for push_back, chunked push_back, pop_back, random get_ref_tuple, sequential iteration and erase.
+//Template parameters are swept one at a time, starting from the default table.
+//Usage: vllt_bench [--rows n] [--reps n] [--threads n] [--csv file] [--json file] [--quick]
+
+
+using types = vtll::tl<uint64_t, double, float, uint32_t>; ///< Columns of all benchmark tables
+
+/// Command line options
+struct options_t {
+	size_t m_rows{ 1 << 20 };	///< Number of rows per operation
+	size_t m_reps{ 3 };			///< Repetitions per measurement, the fastest is reported
+	size_t m_max_threads{ std::max(std::thread::hardware_concurrency(), 1u) }; ///< Max number of threads
+	std::string m_csv;			///< CSV output file, stdout if empty
+	std::string m_json;			///< JSON output file, no JSON if empty
+};
+
+/// One measurement
+struct result_t {
+	std::string m_storage;
+	std::string m_layout;
+	size_t m_n;
+	size_t m_minslots;
+	bool m_fair;
+	std::string m_sync;
+	std::string m_op;
+	size_t m_threads;
+	size_t m_ops;
+	double m_seconds;
+};
+
+std::atomic<uint64_t> g_sink{0}; ///< Results of reads go here, so the compiler cannot remove them
+
+
+auto sync_name(sync_t sync) -> std::string {
+	switch(sync) {
+		case sync_t::VLLT_SYNC_EXTERNAL: return "EXTERNAL";
+		case sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK: return "EXTERNAL_PUSHBACK";
+		case sync_t::VLLT_SYNC_INTERNAL: return "INTERNAL";
+		case sync_t::VLLT_SYNC_INTERNAL_PUSHBACK: return "INTERNAL_PUSHBACK";
+		case sync_t::VLLT_SYNC_DEBUG: return "DEBUG";
+		case sync_t::VLLT_SYNC_DEBUG_PUSHBACK: return "DEBUG_PUSHBACK";
+		case sync_t::VLLT_SYNC_EXTERNAL_APPEND_ONLY: return "EXTERNAL_APPEND_ONLY";
+		case sync_t::VLLT_SYNC_INTERNAL_APPEND_ONLY: return "INTERNAL_APPEND_ONLY";
+		case sync_t::VLLT_SYNC_DEBUG_APPEND_ONLY: return "DEBUG_APPEND_ONLY";
+	}
+	return "UNKNOWN";
+}
+
+auto storage_name(storage_t storage) -> std::string {
+	switch(storage) {
+		case storage_t::VLLT_STORAGE_BLOCK_MAP: return "BLOCK_MAP";
+		case storage_t::VLLT_STORAGE_SEGMENTED: return "SEGMENTED";
+		case storage_t::VLLT_STORAGE_VIRTUAL: return "VIRTUAL";
+	}
+	return "UNKNOWN";
+}
+
+
+/// \brief Run a function in several threads, that all start at the same time.
+/// \param[in] num_threads Number of threads.
+/// \param[in] fun Function that is called as fun(thread index).
+/// \returns Seconds until all threads have finished.
+template<typename F>
+auto run_threads(size_t num_threads, F&& fun) -> double {
+	std::latch start{ (std::ptrdiff_t)num_threads + 1 };
+	std::vector<std::jthread> threads;
+	for( size_t t = 0; t < num_threads; ++t ) {
+		threads.emplace_back( [&, t]() { start.arrive_and_wait(); fun(t); } );
+	}
+	auto t0 = high_resolution_clock::now(); //before the threads are released, they might finish before this thread wakes up
+	start.arrive_and_wait();
+	threads.clear(); //join
+	return duration<double>(high_resolution_clock::now() - t0).count();
+}
+
+
+/// \brief Run an operation opt.m_reps times and return the fastest run. Setting up and destroying the table is not measured.
+/// \param[in] setup Function returning a std::unique_ptr to a new table.
+/// \param[in] fun Function that is called as fun(table, thread index) in each thread.
+template<typename S, typename F>
+auto measure(const options_t& opt, size_t num_threads, S&& setup, F&& fun) -> double {
+	double best = std::numeric_limits<double>::max();
+	for( size_t rep = 0; rep < opt.m_reps; ++rep ) {
+		auto table = setup();
+		best = std::min( best, run_threads(num_threads, [&](size_t t) { fun(*table, t); }) );
+	}
+	return best;
+}
+
+
+/// \brief Benchmark all operations for one table type.
+template<sync_t SYNC, size_t N0, bool ROW, size_t MINSLOTS, bool FAIR, storage_t STORAGE>
+auto bench(const options_t& opt, std::vector<result_t>& results) -> void {
+	using table_t = VlltStaticTable<types, SYNC, N0, ROW, MINSLOTS, FAIR, STORAGE>;
+	const bool PUSHBACK = VlltAllowOnlyPushback<SYNC>;						///< Rows can be added by several threads
+	const bool OWNERS = SYNC == sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK;		///< Rows can be added and removed by several threads
+	const size_t rows = opt.m_rows;
+
+	auto empty = [&]() { return std::make_unique<table_t>(); };
+	auto filled = [&]() {
+		auto table = std::make_unique<table_t>();
+		auto view = table->view();
+		for( size_t i = 0; i < rows; ++i ) view.push_back( (uint64_t)i, (double)i, (float)i, (uint32_t)i );
+		return table;
+	};
+
+	auto add = [&](std::string op, size_t threads, size_t ops, double seconds) {
+		results.push_back( { storage_name(STORAGE), ROW ? "ROW" : "COLUMN", std::bit_ceil(N0), MINSLOTS, FAIR, sync_name(SYNC), op, threads, ops, seconds } );
+		std::cerr << results.back().m_storage << " " << results.back().m_layout << " N=" << results.back().m_n << " MINSLOTS=" << MINSLOTS
+			<< " FAIR=" << FAIR << " " << results.back().m_sync << " " << op << " threads=" << threads << " " << (ops / seconds / 1.0e6) << " Mops/s" << std::endl;
+	};
+
+	std::vector<size_t> thread_counts{1};
+	for( size_t t = 2; t < opt.m_max_threads; t *= 2 ) thread_counts.push_back(t);
+	if( opt.m_max_threads > 1 ) thread_counts.push_back(opt.m_max_threads);
+
+	for( auto threads : thread_counts ) {
+		auto first = [&](size_t t) { return rows * t / threads; };
+
+		if( threads == 1 || PUSHBACK ) {
+			add("push_back", threads, rows, measure(opt, threads, empty, [&](table_t& table, size_t t) {
+				auto push = [&](auto&& view) { for( size_t i = first(t); i < first(t + 1); ++i ) view.push_back( (uint64_t)i, (double)i, (float)i, (uint32_t)i ); };
+				if constexpr (VlltAllowOnlyPushback<SYNC>) push( table.template view<VlltWrite>() );
+				else push( table.view() );
+			}));
+		}
+
+		if constexpr (PUSHBACK) {
+			add("push_back_chunked", threads, rows, measure(opt, threads, empty, [&](table_t& table, size_t t) {
+				auto view = table.template view<VlltWrite, VlltChunk>();
+				for( size_t i = first(t); i < first(t + 1); ++i ) view.push_back( (uint64_t)i, (double)i, (float)i, (uint32_t)i );
+			}));
+		}
+
+		if constexpr (!VlltAppendOnly<SYNC>) { //rows cannot be removed from append-only tables
+			if( threads == 1 || OWNERS ) {
+				add("pop_back", threads, rows, measure(opt, threads, filled, [&](table_t& table, size_t t) {
+					auto view = table.view();
+					for( size_t i = first(t); i < first(t + 1); ++i ) view.pop_back();
+				}));
+			}
+
+			if( threads == 1 || OWNERS ) {
+				add("pop_back_n", threads, rows, measure(opt, threads, filled, [&](table_t& table, size_t t) {
+					auto view = table.view();
+					std::vector<typename table_t::tuple_value_t> values;
+					values.reserve(256);
+					for( size_t i = first(t); i < first(t + 1); i += values.size() ) {
+						values.clear();
+						view.pop_back_n( std::min<size_t>(256, first(t + 1) - i), std::back_inserter(values) );
+					}
+				}));
+			}
+
+			if( threads == 1 ) {
+				add("clear", threads, rows, measure(opt, threads, filled, [&](table_t& table, size_t) { table.view().clear(); }));
+			}
+		}
+
+		add("get_random", threads, rows, measure(opt, threads, filled, [&](table_t& table, size_t t) {
+			auto view = table.template view<uint64_t, double>();
+			uint64_t sum = 0, x = 0x9E3779B97F4A7C15ull * (t + 1);
+			for( size_t i = first(t); i < first(t + 1); ++i ) {
+				x ^= x << 13; x ^= x >> 7; x ^= x << 17; //xorshift
+				auto data = view.get_ref_tuple( table_index_t{ x % rows } );
+				sum += std::get<0>(data) + (uint64_t)std::get<1>(data);
+			}
+			g_sink += sum;
+		}));
+
+		add("iterate", threads, rows, measure(opt, threads, filled, [&](table_t& table, size_t t) {
+			auto view = table.template view<uint64_t, double>();
+			uint64_t sum = 0;
+			for( size_t i = first(t); i < first(t + 1); ++i ) {
+				auto data = view.get_ref_tuple( table_index_t{ i } );
+				sum += std::get<0>(data) + (uint64_t)std::get<1>(data);
+			}
+			g_sink += sum;
+		}));
+
+		if constexpr (!VlltAppendOnly<SYNC>) { //rows cannot be removed from append-only tables
+			if( threads == 1 ) {
+				add("erase", threads, rows / 2, measure(opt, threads, filled, [&](table_t& table, size_t) {
+					auto view = table.view();
+					uint64_t x = 0x9E3779B97F4A7C15ull;
+					for( size_t i = 0; i < rows / 2; ++i ) {
+						x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+						view.erase( table_index_t{ x % (size_t)view.size() } );
+					}
+				}));
+			}
+		}
+	}
+}
+
+
+/// \brief Sweep the block size for one layout.
+template<bool ROW>
+auto bench_n0(const options_t& opt, std::vector<result_t>& results) -> void {
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 4,  ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5,  ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 6,  ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 8,  ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 10, ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 12, ROW, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+}
+
+
+auto write_csv(std::ostream& out, const std::vector<result_t>& results) -> void {
+	out << "storage,layout,n,minslots,fair,sync,op,threads,ops,seconds,mops_per_second\n";
+	for( auto& r : results ) {
+		out << r.m_storage << "," << r.m_layout << "," << r.m_n << "," << r.m_minslots << "," << r.m_fair << "," << r.m_sync << ","
+			<< r.m_op << "," << r.m_threads << "," << r.m_ops << "," << r.m_seconds << "," << (r.m_ops / r.m_seconds / 1.0e6) << "\n";
+	}
+}
+
+
+auto write_json(std::ostream& out, const std::vector<result_t>& results) -> void {
+	out << "[\n";
+	for( size_t i = 0; i < results.size(); ++i ) {
+		auto& r = results[i];
+		out << "  {\"storage\": \"" << r.m_storage << "\", \"layout\": \"" << r.m_layout << "\", \"n\": " << r.m_n
+			<< ", \"minslots\": " << r.m_minslots << ", \"fair\": " << (r.m_fair ? "true" : "false") << ", \"sync\": \"" << r.m_sync
+			<< "\", \"op\": \"" << r.m_op << "\", \"threads\": " << r.m_threads << ", \"ops\": " << r.m_ops << ", \"seconds\": " << r.m_seconds
+			<< ", \"mops_per_second\": " << (r.m_ops / r.m_seconds / 1.0e6) << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+	}
+	out << "]\n";
+}
+
+
+int main(int argc, char* argv[]) {
+	options_t opt;
+	for( int i = 1; i < argc; ++i ) {
+		std::string arg{ argv[i] };
+		auto next = [&]() { return i + 1 < argc ? std::string{ argv[++i] } : std::string{}; };
+		if( arg == "--rows" ) opt.m_rows = std::stoull(next());
+		else if( arg == "--reps" ) opt.m_reps = std::stoull(next());
+		else if( arg == "--threads" ) opt.m_max_threads = std::max( std::stoull(next()), 1ull );
+		else if( arg == "--csv" ) opt.m_csv = next();
+		else if( arg == "--json" ) opt.m_json = next();
+		else if( arg == "--quick" ) { opt.m_rows = 1 << 14; opt.m_reps = 1; }
+		else {
+			std::cerr << "Usage: vllt_bench [--rows n] [--reps n] [--threads n] [--csv file] [--json file] [--quick]" << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<result_t> results;
+
+	//layout and block size
+	bench_n0<false>(opt, results);
+	bench_n0<true>(opt, results);
+
+	//min number of slots of the block map
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5, false, 1,   false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5, false, 256, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+
+	//fairness
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5, false, 16, true, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+
+	//sync modes
+	bench<sync_t::VLLT_SYNC_EXTERNAL,          1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_INTERNAL,          1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_INTERNAL_PUSHBACK, 1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_DEBUG,             1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_DEBUG_PUSHBACK,    1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_APPEND_ONLY, 1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_INTERNAL_APPEND_ONLY, 1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+	bench<sync_t::VLLT_SYNC_DEBUG_APPEND_ONLY,    1 << 5, false, 16, false, storage_t::VLLT_STORAGE_BLOCK_MAP>(opt, results);
+
+	//storage engines
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5, false, 16, false, storage_t::VLLT_STORAGE_SEGMENTED>(opt, results);
+	bench<sync_t::VLLT_SYNC_EXTERNAL_PUSHBACK, 1 << 5, false, 16, false, storage_t::VLLT_STORAGE_VIRTUAL>(opt, results);
+
+	if( opt.m_csv.empty() ) write_csv(std::cout, results);
+	else { std::ofstream out{ opt.m_csv }; write_csv(out, results); }
+
+	if( !opt.m_json.empty() ) { std::ofstream out{ opt.m_json }; write_json(out, results); }
+
+	return 0;
+}